@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/any_vector.h"
+
+namespace cec = constexpr_containers;
+
+// A plugin-defined record, seen by the host either through a base class or a descriptor
+struct element_base
+{
+  virtual ~element_base() = default;
+  virtual std::uint64_t weight() const = 0;
+};
+
+struct particle final : element_base
+{
+  double position[3] = {};
+  double velocity[3] = {};
+  std::uint64_t id = 0;
+
+  explicit particle(std::uint64_t i = 0)
+    : id(i)
+  {}
+  std::uint64_t weight() const override { return id; }
+};
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 20;
+  std::uint64_t sum = 0;
+
+  bench::report("1M elements, build", "vector<unique_ptr>", bench::ns_per_item(n, [&] {
+                  std::vector<std::unique_ptr<element_base>> v;
+                  for (std::size_t i = 0; i < n; ++i) {
+                    v.push_back(std::make_unique<particle>(i));
+                  }
+                  bench::do_not_optimize(v.data());
+                }));
+  bench::report("1M elements, build", "any_vector", bench::ns_per_item(n, [&] {
+                  cec::any_vector<> v(cec::descriptor_of<particle>);
+                  for (std::size_t i = 0; i < n; ++i) {
+                    v.emplace_back<particle>(i);
+                  }
+                  bench::do_not_optimize(v.data());
+                }));
+
+  std::vector<std::unique_ptr<element_base>> pointers;
+  cec::any_vector<> elements(cec::descriptor_of<particle>);
+  for (std::size_t i = 0; i < n; ++i) {
+    pointers.push_back(std::make_unique<particle>(i));
+    elements.emplace_back<particle>(i);
+  }
+  // Scatters the heap objects the way a long-running host would
+  for (std::size_t i = 0; i < n; i += 2) {
+    pointers[i] = std::make_unique<particle>(i);
+  }
+  bench::report("1M elements, iterate", "vector<unique_ptr>", bench::ns_per_item(n, [&] {
+                  for (const auto& p : pointers) {
+                    sum += p->weight();
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("1M elements, iterate", "any_vector", bench::ns_per_item(n, [&] {
+                  for (const auto& p : std::as_const(elements).as_span<particle>()) {
+                    sum += p.weight();
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("1M elements, copy", "any_vector", bench::ns_per_item(n, [&] {
+                  const auto copy = elements;
+                  bench::do_not_optimize(copy.data());
+                }));
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/archetype_store.h"
+
+namespace cec = constexpr_containers;
+
+struct position
+{
+  float x, y, z;
+};
+struct velocity
+{
+  float dx, dy, dz;
+};
+struct health
+{
+  int hp;
+};
+struct name
+{
+  char text[32];
+};
+
+// The layout the store replaces: every entity with a slot for every component
+struct entity_record
+{
+  std::optional<position> p;
+  std::optional<velocity> v;
+  std::optional<health> h;
+  std::optional<name> n;
+};
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 20;
+  cec::archetype_store<position, velocity, health, name> world;
+  std::vector<entity_record> records(n);
+  std::mt19937 rng(6);
+  std::size_t moving = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto e = world.create(position{ 0, 0, 0 }, name{});
+    records[i].p = position{ 0, 0, 0 };
+    records[i].n = name{};
+    if (rng() % 2) {
+      world.add(e, velocity{ 1, 1, 1 });
+      records[i].v = velocity{ 1, 1, 1 };
+      ++moving;
+    }
+    if (rng() % 4 == 0) {
+      world.add(e, health{ 100 });
+      records[i].h = health{ 100 };
+    }
+  }
+
+  bench::report("1M entities, integrate", "records of optionals", bench::ns_per_item(moving, [&] {
+                  for (auto& r : records) {
+                    if (r.v) {
+                      r.p->x += r.v->dx;
+                      r.p->y += r.v->dy;
+                      r.p->z += r.v->dz;
+                    }
+                  }
+                  bench::do_not_optimize(records.data());
+                }));
+  const auto integrate = [](position& p, const velocity& v) {
+    p.x += v.dx;
+    p.y += v.dy;
+    p.z += v.dz;
+  };
+  bench::report("1M entities, integrate", "archetype_store each", bench::ns_per_item(moving, [&] {
+                  world.each<position, velocity>(integrate);
+                  bench::do_not_optimize(world.size());
+                }));
+  const auto threads = std::max(1u, std::thread::hardware_concurrency());
+  bench::report("1M entities, integrate", "  parallel_each", bench::ns_per_item(moving, [&] {
+                  world.parallel_each<position, velocity>(threads, integrate);
+                  bench::do_not_optimize(world.size());
+                }));
+
+  bench::report("1M entities", "add + remove health", bench::ns_per_item(n, [&] {
+                  for (std::uint32_t e = 0; e < n; ++e) {
+                    if (world.has<health>(e)) {
+                      world.remove<health>(e);
+                    } else {
+                      world.add(e, health{ 1 });
+                    }
+                  }
+                }, 3));
+}
@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <system_error>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "constexpr_containers/async_loader.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Loads 256 files at startup, from the page cache, then from the disk after evicting them
+int
+main()
+{
+  const std::size_t files = 256;
+  const std::size_t n = std::size_t{ 1 } << 17;
+  cec::vector<int> fds;
+  cec::vector<std::uint32_t> values(n, 7);
+  for (std::size_t f = 0; f < files; ++f) {
+    char path[] = "/tmp/constexpr_containers_bench_loader_XXXXXX";
+    const int fd = ::mkstemp(path);
+    const auto bytes = static_cast<ssize_t>(n * sizeof(std::uint32_t));
+    if (fd < 0 or ::write(fd, values.data(), n * sizeof(std::uint32_t)) != bytes) {
+      std::perror("write");
+      return 1;
+    }
+    ::fsync(fd);
+    ::unlink(path);
+    fds.push_back(fd);
+  }
+
+  const auto load_all = [&](auto load) {
+    cec::vector<cec::vector<std::uint32_t>> out(files);
+    load(out);
+    bench::do_not_optimize(out[files - 1].data());
+  };
+  const auto sequential = [&](auto& out) {
+    for (std::size_t f = 0; f < files; ++f) {
+      cec::read_into(fds[f], out[f], cec::all_bytes, 0);
+    }
+  };
+  const auto with_loader = [&](cec::io_backend backend) {
+    return [&fds, backend](auto& out) {
+      cec::async_loader loader(backend, 16);
+      for (std::size_t f = 0; f < files; ++f) {
+        loader.enqueue(fds[f], out[f]);
+      }
+      loader.wait([](std::size_t, std::size_t, std::error_code) {});
+    };
+  };
+
+  for (const bool cold : { false, true }) {
+    const char* group = cold ? "512 KiB files, cold (per file)" : "512 KiB files (per file)";
+    const auto run = [&](const char* name, auto load) {
+      bench::report(group, name, bench::ns_per_item(files, [&] {
+                      if (cold) {
+                        for (const int fd : fds) {
+                          ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                        }
+                      }
+                      load_all(load);
+                    }));
+    };
+    run("read_into, one by one", sequential);
+    run("async_loader (pread)", with_loader(cec::io_backend::system_calls));
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    if (cec::uring::available()) {
+      run("async_loader (io_uring)", with_loader(cec::io_backend::io_uring));
+    }
+#endif
+  }
+  for (const int fd : fds) {
+    ::close(fd);
+  }
+}
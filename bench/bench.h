@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+// Minimal timing helpers shared by the benchmarks.
+namespace bench {
+
+// Keeps the compiler from discarding a computed value
+template<typename T>
+inline void
+do_not_optimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs op reps times and returns the best time per item, in nanoseconds
+template<typename Op>
+double
+ns_per_item(std::size_t items, Op op, int reps = 5)
+{
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < reps; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    op();
+    const auto stop = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  return best / static_cast<double>(items);
+}
+
+inline void
+report(const char* group, const char* name, double ns)
+{
+  std::printf("%-28s %-28s %8.3f ns/item\n", group, name, ns);
+}
+
+} // namespace bench
@@ -0,0 +1,93 @@
+#!/bin/sh
+# Compile time of a synthetic project of many translation units, each using vector_base for the
+# common element types plus a heap. Run through `make compile-bench`, which passes CXX,
+# CXXFLAGS and MODULE_CXXFLAGS and builds the library first.
+#
+# Usage: compile_time.sh DIR [UNITS]
+set -e
+
+dir=$1
+units=${2:-24}
+mkdir -p "$dir"
+
+# Body of every unit, with a different function name each
+body() {
+  cat <<BODY
+namespace cec = constexpr_containers;
+
+double unit_$1(int n)
+{
+  cec::vector<int> a(n);
+  cec::vector<double> b(n, 1.0);
+  cec::vector<std::uint64_t> c{ 1, 2, 3 };
+  cec::vector<std::byte> d;
+  for (int i = 0; i < n; ++i) {
+    a.push_back(i);
+    b.push_back(i * 0.5);
+    c.push_back(std::uint64_t(i));
+    d.push_back(std::byte(i));
+  }
+  a.reserve(100);
+  b.resize(50);
+  c.resize(70, 3);
+  auto e = a;
+  e = a;
+  b.shrink_to_fit();
+  cec::dary_heap<int, 4> heap(a.begin(), a.end());
+  heap.push(n);
+  return double(a.size() + e.size() + d.size()) + b[3] + double(c.back()) + heap.top();
+}
+BODY
+}
+
+i=0
+while [ "$i" -lt "$units" ]; do
+  {
+    echo '#include <cstddef>'
+    echo '#include <cstdint>'
+    echo '#include "constexpr_containers/dary_heap.h"'
+    echo '#include "constexpr_containers/vector.h"'
+    body "$i"
+  } > "$dir/include_$i.cc"
+  {
+    echo '#include <cstddef>'
+    echo '#include <cstdint>'
+    echo '#include "constexpr_containers/dary_heap.h"'
+    echo '#include "constexpr_containers/extern_templates.h"'
+    echo '#include "constexpr_containers/vector.h"'
+    body "$i"
+  } > "$dir/extern_$i.cc"
+  {
+    echo '#include <cstddef>'
+    echo '#include <cstdint>'
+    echo '#include <new>'
+    echo 'import constexpr_containers;'
+    body "$i"
+  } > "$dir/import_$i.cc"
+  i=$((i + 1))
+done
+
+now_ms() {
+  echo $(($(date +%s%N) / 1000000))
+}
+
+# Compiles every unit of one variant in turn, reports the time per unit and the object size
+run() {
+  variant=$1
+  shift
+  start=$(now_ms)
+  i=0
+  while [ "$i" -lt "$units" ]; do
+    $CXX $CXXFLAGS "$@" -c "$dir/${variant}_$i.cc" -o "$dir/${variant}_$i.o"
+    i=$((i + 1))
+  done
+  stop=$(now_ms)
+  bytes=$(cat "$dir"/"${variant}"_*.o | wc -c)
+  printf '%-10s %-24s %8d ms/unit %10d object bytes/unit\n' \
+    "$units units" "$variant" $(((stop - start) / units)) $((bytes / units))
+}
+
+run include
+run extern
+# shellcheck disable=SC2086
+run import $MODULE_CXXFLAGS
@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "bench.h"
+#include "constexpr_containers/csr_graph.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+int
+main()
+{
+  const std::uint32_t vertices = 1u << 22;
+  const std::size_t n = std::size_t{ 1 } << 26;
+  std::mt19937 rng(42);
+  cec::vector<std::pair<std::uint32_t, std::uint32_t>> edges(n);
+  for (auto& e : edges) {
+    e = { rng() % vertices, rng() % vertices };
+  }
+
+  const auto cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= cores; threads *= 2) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "build, %u threads", threads);
+    bench::report("64M edges, 4M vertices", name, bench::ns_per_item(n, [&] {
+                    const cec::csr_graph<> graph(edges, vertices, threads);
+                    bench::do_not_optimize(graph.targets().data());
+                  }, 3));
+  }
+
+  const cec::csr_graph<> graph(edges, vertices);
+  std::size_t depth_sum = 0;
+  bench::report("64M edges, 4M vertices", "bfs", bench::ns_per_item(n, [&] {
+                  bfs(graph, std::uint32_t{ 0 }, [&](std::uint32_t, std::size_t d) {
+                    depth_sum += d;
+                  });
+                  bench::do_not_optimize(depth_sum);
+                }, 3));
+}
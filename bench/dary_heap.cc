@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/dary_heap.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Scheduler loop over a timer queue: fire the earliest timer, then re-arm it at a random delay
+// from its deadline. Deadlines are 64-bit ticks.
+template<typename Heap, typename Rearm>
+double
+run_scheduler(Heap& heap, const cec::vector<std::uint64_t>& delays, Rearm rearm)
+{
+  return bench::ns_per_item(delays.size(), [&] {
+    for (auto delay : delays) {
+      rearm(heap, heap.top() + delay);
+    }
+    bench::do_not_optimize(heap.top());
+  });
+}
+
+template<std::size_t D>
+void
+run_dary(const char* group, const char* name, const cec::vector<std::uint64_t>& deadlines,
+         const cec::vector<std::uint64_t>& delays)
+{
+  cec::dary_heap<std::uint64_t, D, std::greater<>> heap(deadlines.begin(), deadlines.end());
+  bench::report(group, name, run_scheduler(heap, delays, [](auto& h, std::uint64_t next) {
+                  h.pop();
+                  h.push(next);
+                }));
+}
+
+int
+main()
+{
+  std::mt19937_64 rng(42);
+  const std::size_t ops = std::size_t{ 1 } << 22;
+  cec::vector<std::uint64_t> delays(ops);
+  for (auto& d : delays) {
+    d = 1 + rng() % 1000000;
+  }
+
+  for (int log_timers : { 10, 16, 22 }) {
+    const auto timers = std::size_t{ 1 } << log_timers;
+    cec::vector<std::uint64_t> deadlines(timers);
+    for (auto& d : deadlines) {
+      d = rng() % 1000000;
+    }
+    char group[32];
+    std::snprintf(group, sizeof(group), "%zu timers", timers);
+
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>> pq(
+      std::greater<>(), std::vector<std::uint64_t>(deadlines.begin(), deadlines.end()));
+    bench::report(group, "std::priority_queue", run_scheduler(pq, delays, [](auto& h, auto next) {
+                    h.pop();
+                    h.push(next);
+                  }));
+    run_dary<2>(group, "dary_heap<2> pop+push", deadlines, delays);
+    run_dary<4>(group, "dary_heap<4> pop+push", deadlines, delays);
+    run_dary<8>(group, "dary_heap<8> pop+push", deadlines, delays);
+
+    cec::dary_heap<std::uint64_t, 4, std::greater<>> heap(deadlines.begin(), deadlines.end());
+    const auto replace_top = [](auto& h, auto next) { h.replace_top(next); };
+    bench::report(group, "dary_heap<4> replace_top", run_scheduler(heap, delays, replace_top));
+
+    cec::indexed_dary_heap<std::uint64_t, 4, std::greater<>> indexed(deadlines.begin(),
+                                                                     deadlines.end());
+    const auto update_top = [](auto& h, auto next) { h.update(h.top_handle(), next); };
+    bench::report(group, "indexed_dary_heap<4> update", run_scheduler(indexed, delays, update_top));
+  }
+}
@@ -0,0 +1,48 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "bench.h"
+#include "constexpr_containers/delta_vector.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Decodes 16 Mi sorted uint32 with gaps of up to max_gap, against copying them uncompressed
+void
+run(const char* group, std::uint32_t max_gap)
+{
+  const std::size_t n = std::size_t{ 1 } << 24;
+  std::mt19937 rng(42);
+  cec::vector<std::uint32_t> plain(n);
+  std::uint32_t x = 0;
+  for (auto& value : plain) {
+    value = x += rng() % (max_gap + 1);
+  }
+  cec::delta_vector<std::uint32_t> packed(plain.begin(), plain.end());
+
+  bench::report(group, "copy uncompressed", bench::ns_per_item(n, [&] {
+                  cec::vector<std::uint32_t> out(plain);
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(group, "decode", bench::ns_per_item(n, [&] {
+                  cec::vector<std::uint32_t> out;
+                  packed.decode(out);
+                  bench::do_not_optimize(out.data());
+                }));
+  // Into a buffer that stays in L1, leaving out the page faults of a fresh output
+  bench::report(group, "decode_block, reused buffer", bench::ns_per_item(n, [&] {
+                  std::uint32_t block[packed.block_size];
+                  for (std::size_t b = 0; b < packed.block_count(); ++b) {
+                    packed.decode_block(b, block);
+                    bench::do_not_optimize(block[0]);
+                  }
+                }));
+}
+
+int
+main()
+{
+  run("decode 16 Mi, gaps < 16", 15);
+  run("decode 16 Mi, gaps < 65536", 65535);
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+
+#include "bench.h"
+#include "constexpr_containers/filter.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Lookups in a large sorted vector, 90% of them for absent keys, guarded by each filter
+template<typename Filter>
+void
+bench_guarded(const char* name,
+              const cec::vector<std::uint64_t>& sorted,
+              const cec::vector<std::uint64_t>& queries)
+{
+  const Filter filter(sorted);
+  std::size_t found = 0;
+  bench::report("8M keys, 10% hits", name, bench::ns_per_item(queries.size(), [&] {
+                  for (const auto q : queries) {
+                    found += filter.contains(q) and
+                             std::binary_search(sorted.begin(), sorted.end(), q);
+                  }
+                  bench::do_not_optimize(found);
+                }, 3));
+
+  const auto maybe = std::make_unique<bool[]>(queries.size());
+  const std::span out(maybe.get(), queries.size());
+  bench::report("8M keys, 10% hits", "  batched", bench::ns_per_item(queries.size(), [&] {
+                  filter.contains_each(queries, out);
+                  for (std::size_t i = 0; i < queries.size(); ++i) {
+                    found += out[i] and
+                             std::binary_search(sorted.begin(), sorted.end(), queries[i]);
+                  }
+                  bench::do_not_optimize(found);
+                }, 3));
+}
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 23;
+  std::mt19937_64 rng(9);
+  cec::vector<std::uint64_t> sorted(n);
+  for (auto& k : sorted) {
+    k = rng();
+  }
+  std::sort(sorted.begin(), sorted.end());
+  cec::vector<std::uint64_t> queries(n);
+  for (auto& q : queries) {
+    q = rng() % 10 == 0 ? sorted[rng() % n] : rng();
+  }
+
+  std::size_t found = 0;
+  bench::report("8M keys, 10% hits", "binary search", bench::ns_per_item(n, [&] {
+                  for (const auto q : queries) {
+                    found += std::binary_search(sorted.begin(), sorted.end(), q);
+                  }
+                  bench::do_not_optimize(found);
+                }, 3));
+  bench_guarded<cec::bloom_filter<>>("bloom_filter", sorted, queries);
+  bench_guarded<cec::xor_filter<>>("xor_filter", sorted, queries);
+  bench_guarded<cec::xor_filter<std::uint16_t>>("xor_filter<uint16_t>", sorted, queries);
+
+  bench::report("8M keys", "build bloom_filter", bench::ns_per_item(n, [&] {
+                  const cec::bloom_filter<> filter(sorted);
+                  bench::do_not_optimize(filter.data().data());
+                }, 3));
+  bench::report("8M keys", "build xor_filter", bench::ns_per_item(n, [&] {
+                  const cec::xor_filter<> filter(sorted);
+                  bench::do_not_optimize(filter.data().data());
+                }, 1));
+}
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+#include "bench.h"
+#include "constexpr_containers/gather.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+template<typename T>
+void
+run(const char* pattern, const cec::vector<T>& in, const cec::vector<std::uint32_t>& idx)
+{
+  const auto n = idx.size();
+  cec::vector<T> out(n);
+
+  bench::report(pattern, "scalar gather", bench::ns_per_item(n, [&] {
+                  for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = in[idx[i]];
+                  }
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "gather", bench::ns_per_item(n, [&] {
+                  cec::gather(in, idx, out);
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "gather_blocked", bench::ns_per_item(n, [&] {
+                  cec::gather_blocked(in, idx, out);
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "scalar scatter", bench::ns_per_item(n, [&] {
+                  for (std::size_t i = 0; i < n; ++i) {
+                    out[idx[i]] = in[i];
+                  }
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "scatter", bench::ns_per_item(n, [&] {
+                  cec::scatter(in, idx, out);
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "scatter_blocked", bench::ns_per_item(n, [&] {
+                  cec::scatter_blocked(in, idx, out);
+                  bench::do_not_optimize(out.data());
+                }));
+  bench::report(pattern, "apply_permutation", bench::ns_per_item(n, [&] {
+                  cec::apply_permutation(out, idx);
+                  bench::do_not_optimize(out.data());
+                }));
+}
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 24;
+  std::mt19937_64 rng(42);
+
+  cec::vector<std::uint32_t> values(n);
+  std::iota(values.begin(), values.end(), 0u);
+
+  cec::vector<std::uint32_t> random(n);
+  std::iota(random.begin(), random.end(), 0u);
+  std::shuffle(random.begin(), random.end(), rng);
+
+  // Shuffled within windows of 4096 elements, as after a partial sort or a local reordering
+  cec::vector<std::uint32_t> clustered(n);
+  std::iota(clustered.begin(), clustered.end(), 0u);
+  for (std::size_t i = 0; i < n; i += 4096) {
+    std::shuffle(clustered.begin() + i, clustered.begin() + i + 4096, rng);
+  }
+
+  run("random uint32", values, random);
+  run("clustered uint32", values, clustered);
+
+  cec::vector<std::uint64_t> wide(values.begin(), values.end());
+  run("random uint64", wide, random);
+  run("clustered uint64", wide, clustered);
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "bench.h"
+#include "constexpr_containers/generator.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+std::uint32_t
+value(std::size_t i)
+{
+  return static_cast<std::uint32_t>(i * 2654435761U);
+}
+
+cec::generator<std::uint32_t>
+values(std::size_t n, bool hint)
+{
+  if (hint) {
+    co_yield cec::size_hint{ n };
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    co_yield value(i);
+  }
+}
+
+cec::batch_generator<std::uint32_t>
+value_batches(std::size_t n, std::size_t batch)
+{
+  co_yield cec::size_hint{ n };
+  cec::vector<std::uint32_t> buffer(batch);
+  for (std::size_t i = 0; i < n; i += batch) {
+    const auto count = std::min(batch, n - i);
+    for (std::size_t j = 0; j < count; ++j) {
+      buffer[j] = value(i + j);
+    }
+    co_yield std::span<const std::uint32_t>(buffer.data(), count);
+  }
+}
+
+// Collects 16 Mi computed values, against the loop that would compute them in place
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 24;
+  const char* group = "collect 16 Mi uint32";
+  const auto run = [&](const char* name, auto fill) {
+    bench::report(group, name, bench::ns_per_item(n, [&] {
+                    cec::vector<std::uint32_t> v;
+                    fill(v);
+                    bench::do_not_optimize(v.data());
+                  }));
+  };
+
+  run("loop + push_back", [&](auto& v) {
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(value(i));
+    }
+  });
+  run("reserve + loop + push_back", [&](auto& v) {
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(value(i));
+    }
+  });
+  run("generator + push_back", [&](auto& v) {
+    for (const auto x : values(n, false)) {
+      v.push_back(x);
+    }
+  });
+  run("collect_into", [&](auto& v) { cec::collect_into(values(n, false), v); });
+  run("collect_into, size hint", [&](auto& v) { cec::collect_into(values(n, true), v); });
+  run("collect_into, 1024 batches", [&](auto& v) {
+    cec::collect_into(value_batches(n, 1024), v);
+  });
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Parsing cost of each public header on its own: preprocessed size and the time to compile a
+# translation unit that only includes it. Sizes are checked against bench/header_budget.txt, so
+# that a new include in a widely used header shows up as a failure. Run through
+# `make header-bench`, which passes CXX and CXXFLAGS.
+#
+# Usage: header_cost.sh BUDGET_FILE
+set -e
+
+budget_file=$1
+status=0
+
+now_ms() {
+  echo $(($(date +%s%N) / 1000000))
+}
+
+printf '%-40s %10s %10s %8s\n' header bytes budget ms
+while read -r header budget; do
+  case $header in
+    '#'* | '') continue ;;
+  esac
+  source="#include \"constexpr_containers/$header\""
+  bytes=$(echo "$source" | $CXX $CXXFLAGS -x c++ -E -P - | wc -c)
+  # Best of three, as a single run is noisy
+  best=
+  for _ in 1 2 3; do
+    start=$(now_ms)
+    echo "$source" | $CXX $CXXFLAGS -x c++ -fsyntax-only -
+    ms=$(($(now_ms) - start))
+    if [ -z "$best" ] || [ "$ms" -lt "$best" ]; then
+      best=$ms
+    fi
+  done
+  flag=
+  if [ "$bytes" -gt "$budget" ]; then
+    flag='  over budget'
+    status=1
+  fi
+  printf '%-40s %10d %10d %8d%s\n' "$header" "$bytes" "$budget" "$best" "$flag"
+done < "$budget_file"
+
+exit $status
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "constexpr_containers/io.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Loads a file of uint32_t that the first pass brings into the page cache, so that loaders are
+// compared against memory bandwidth rather than the disk
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 25;
+  char path[] = "/tmp/constexpr_containers_bench_io_XXXXXX";
+  const int out = ::mkstemp(path);
+  {
+    cec::vector<std::uint32_t> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      values[i] = static_cast<std::uint32_t>(i * 2654435761U);
+    }
+    const auto bytes = static_cast<ssize_t>(n * sizeof(std::uint32_t));
+    if (out < 0 or ::write(out, values.data(), n * sizeof(std::uint32_t)) != bytes) {
+      std::perror("write");
+      return 1;
+    }
+    ::close(out);
+  }
+
+  const char* group = "load 128 MiB (per uint32)";
+  bench::report(group, "ifstream + push_back", bench::ns_per_item(n, [&] {
+                  std::ifstream is(path, std::ios::binary);
+                  cec::vector<std::uint32_t> v;
+                  std::uint32_t x;
+                  while (is.read(reinterpret_cast<char*>(&x), sizeof(x))) {
+                    v.push_back(x);
+                  }
+                  bench::do_not_optimize(v.data());
+                }));
+  bench::report(group, "resize + read", bench::ns_per_item(n, [&] {
+                  const int fd = ::open(path, O_RDONLY);
+                  std::vector<std::uint32_t> v(n);
+                  auto* dst = reinterpret_cast<char*>(v.data());
+                  std::size_t done = 0;
+                  for (ssize_t got; done < n * sizeof(std::uint32_t); done += got) {
+                    got = ::read(fd, dst + done, n * sizeof(std::uint32_t) - done);
+                    if (got <= 0) {
+                      break;
+                    }
+                  }
+                  ::close(fd);
+                  bench::do_not_optimize(v.data());
+                }));
+  bench::report(group, "read_into", bench::ns_per_item(n, [&] {
+                  const int fd = ::open(path, O_RDONLY);
+                  cec::vector<std::uint32_t> v;
+                  cec::read_into(fd, v);
+                  ::close(fd);
+                  bench::do_not_optimize(v.data());
+                }));
+  bench::report(group, "append_from(ifstream)", bench::ns_per_item(n, [&] {
+                  std::ifstream is(path, std::ios::binary);
+                  cec::vector<std::uint32_t> v;
+                  cec::append_from(is, v);
+                  bench::do_not_optimize(v.data());
+                }));
+
+  // The same bytes as a checkpoint of many vectors, written back over the file
+  const std::size_t parts = 4096;
+  cec::vector<cec::vector<std::uint32_t>> checkpoint;
+  for (std::size_t p = 0; p < parts; ++p) {
+    checkpoint.push_back(cec::vector<std::uint32_t>(n / parts, static_cast<std::uint32_t>(p)));
+  }
+  const int fd = ::open(path, O_WRONLY);
+  group = "write 4096 x 32 KiB";
+  bench::report(group, "staging copy + write", bench::ns_per_item(n, [&] {
+                  cec::vector<std::byte> staging(n * sizeof(std::uint32_t));
+                  auto* dst = staging.data();
+                  for (const auto& part : checkpoint) {
+                    const auto bytes = cec::as_bytes(part);
+                    dst = std::copy(bytes.begin(), bytes.end(), dst);
+                  }
+                  cec::vectored_writer writer(fd, 0, cec::io_backend::system_calls);
+                  writer.add(staging);
+                  writer.flush();
+                }));
+  const auto vectored = [&](cec::io_backend backend) {
+    return bench::ns_per_item(n, [&] {
+      cec::vectored_writer writer(fd, 0, backend);
+      for (const auto& part : checkpoint) {
+        writer.add(part);
+      }
+      writer.flush();
+    });
+  };
+  bench::report(group, "vectored_writer (pwritev)", vectored(cec::io_backend::system_calls));
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  if (cec::uring::available()) {
+    bench::report(group, "vectored_writer (io_uring)", vectored(cec::io_backend::io_uring));
+  }
+#endif
+  ::close(fd);
+  std::remove(path);
+}
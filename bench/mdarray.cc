@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <random>
+#include <utility>
+
+#include "bench.h"
+#include "constexpr_containers/mdarray.h"
+
+namespace cec = constexpr_containers;
+
+using matrix_extents = cec::dextents<std::size_t, 2>;
+
+// Sums every column, walking down each one
+template<typename Layout>
+double
+column_sums(const cec::mdarray<float, matrix_extents, Layout>& m)
+{
+  const auto view = m.to_mdspan();
+  double total = 0;
+  for (std::size_t j = 0; j < view.extent(1); ++j) {
+    float sum = 0;
+    for (std::size_t i = 0; i < view.extent(0); ++i) {
+      sum += view(i, j);
+    }
+    total += sum;
+  }
+  return total;
+}
+
+template<typename Layout>
+void
+bench_columns(const char* name, std::size_t n)
+{
+  cec::mdarray<float, matrix_extents, Layout> m(n, n);
+  std::mt19937 rng(1);
+  for (auto& x : m.container()) {
+    x = float(rng() % 16);
+  }
+  bench::report("column sums, 4096^2", name, bench::ns_per_item(n * n, [&] {
+                  bench::do_not_optimize(column_sums(m));
+                }));
+}
+
+int
+main()
+{
+  const std::size_t n = 4096;
+  bench_columns<cec::layout_right>("row-major", n);
+  bench_columns<cec::layout_left>("column-major", n);
+  bench_columns<cec::layout_tiled<16, 16>>("tiled 16x16", n);
+  bench_columns<cec::layout_tiled<64, 16>>("tiled 64x16", n);
+
+  cec::mdarray<float, matrix_extents> a(n, n);
+  cec::mdarray<float, matrix_extents> b(n, n);
+  bench::report("transpose, 4096^2", "naive", bench::ns_per_item(n * n, [&] {
+                  for (std::size_t i = 0; i < n; ++i) {
+                    for (std::size_t j = 0; j < n; ++j) {
+                      b(j, i) = a(i, j);
+                    }
+                  }
+                  bench::do_not_optimize(b.data());
+                }, 3));
+  bench::report("transpose, 4096^2", "blocked", bench::ns_per_item(n * n, [&] {
+                  cec::transpose(std::as_const(a).to_mdspan(), b.to_mdspan());
+                  bench::do_not_optimize(b.data());
+                }, 3));
+
+  cec::mdarray<float, matrix_extents, cec::layout_tiled<16, 16>> t(n, n);
+  bench::report("transpose, 4096^2", "row-major to tiled", bench::ns_per_item(n * n, [&] {
+                  cec::transpose(std::as_const(a).to_mdspan(), t.to_mdspan());
+                  bench::do_not_optimize(t.data());
+                }, 3));
+}
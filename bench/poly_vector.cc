@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/poly_vector.h"
+
+namespace cec = constexpr_containers;
+
+struct shape
+{
+  virtual ~shape() = default;
+  virtual double area() const = 0;
+};
+
+struct circle final : shape
+{
+  double r;
+  explicit circle(double x)
+    : r(x)
+  {}
+  double area() const override { return 3.14159 * r * r; }
+};
+
+struct rect final : shape
+{
+  double w, h;
+  explicit rect(double x)
+    : w(x)
+    , h(x + 1)
+  {}
+  double area() const override { return w * h; }
+};
+
+struct triangle final : shape
+{
+  double b, h, unused[2] = {};
+  explicit triangle(double x)
+    : b(x)
+    , h(x * 2)
+  {}
+  double area() const override { return 0.5 * b * h; }
+};
+
+template<typename Add>
+void
+fill(std::size_t n, Add add)
+{
+  std::mt19937 rng(3);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto x = double(rng() % 100);
+    switch (rng() % 3) {
+      case 0: add.template operator()<circle>(x); break;
+      case 1: add.template operator()<rect>(x); break;
+      default: add.template operator()<triangle>(x); break;
+    }
+  }
+}
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 20;
+  std::vector<std::unique_ptr<shape>> pointers;
+  cec::poly_vector<shape> shapes;
+  fill(n, [&]<typename T>(double x) {
+    pointers.push_back(std::make_unique<T>(x));
+    shapes.emplace_back<T>(x);
+  });
+  // Frees and reallocates a third of the heap objects, as a long-running program would
+  std::mt19937 rng(4);
+  for (std::size_t i = 0; i < n / 3; ++i) {
+    auto& p = pointers[rng() % n];
+    p = std::make_unique<rect>(p->area());
+  }
+
+  double sum = 0;
+  bench::report("1M shapes, sum of areas", "vector<unique_ptr>", bench::ns_per_item(n, [&] {
+                  for (const auto& p : pointers) {
+                    sum += p->area();
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("1M shapes, sum of areas", "poly_vector", bench::ns_per_item(n, [&] {
+                  for (const auto& s : shapes) {
+                    sum += s.area();
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  shapes.group_by_type();
+  bench::report("1M shapes, sum of areas", "  grouped by type", bench::ns_per_item(n, [&] {
+                  for (const auto& s : shapes) {
+                    sum += s.area();
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("1M shapes, sum of areas", "  for_each_of", bench::ns_per_item(n, [&] {
+                  shapes.for_each_of<circle>([&](const circle& c) { sum += c.area(); });
+                  shapes.for_each_of<rect>([&](const rect& r) { sum += r.area(); });
+                  shapes.for_each_of<triangle>([&](const triangle& t) { sum += t.area(); });
+                  bench::do_not_optimize(sum);
+                }));
+}
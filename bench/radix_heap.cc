@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "bench.h"
+#include "constexpr_containers/dary_heap.h"
+#include "constexpr_containers/radix_heap.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+struct graph
+{
+  cec::vector<std::uint32_t> offsets;
+  cec::vector<std::uint32_t> targets;
+  cec::vector<std::uint32_t> weights;
+};
+
+// Random directed graph with degree edges out of every vertex and weights in [1, max_weight]
+graph
+random_graph(std::uint32_t vertices, std::uint32_t degree, std::uint32_t max_weight)
+{
+  std::mt19937 rng(42);
+  graph g;
+  g.offsets.resize(vertices + 1);
+  g.targets.resize(std::size_t{ vertices } * degree);
+  g.weights.resize(std::size_t{ vertices } * degree);
+  for (std::uint32_t v = 0; v <= vertices; ++v) {
+    g.offsets[v] = v * degree;
+  }
+  for (std::size_t e = 0; e < g.targets.size(); ++e) {
+    g.targets[e] = rng() % vertices;
+    g.weights[e] = 1 + rng() % max_weight;
+  }
+  return g;
+}
+
+constexpr auto unreached = std::numeric_limits<std::uint64_t>::max();
+
+// Lazy deletion: stale entries are skipped when popped. Push(queue, distance, vertex) and
+// pop(queue) -> (distance, vertex) adapt the queue interfaces.
+template<typename Queue, typename Push, typename Pop>
+void
+dijkstra(const graph& g, Queue& queue, cec::vector<std::uint64_t>& dist, Push push, Pop pop)
+{
+  std::fill(dist.begin(), dist.end(), unreached);
+  dist[0] = 0;
+  push(queue, 0, 0);
+  while (not queue.empty()) {
+    const auto [d, v] = pop(queue);
+    if (d != dist[v]) {
+      continue;
+    }
+    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+      const auto next = d + g.weights[e];
+      if (next < dist[g.targets[e]]) {
+        dist[g.targets[e]] = next;
+        push(queue, next, g.targets[e]);
+      }
+    }
+  }
+}
+
+void
+run(const char* group, std::uint32_t vertices, std::uint32_t max_weight)
+{
+  const auto g = random_graph(vertices, 8, max_weight);
+  const auto edges = g.targets.size();
+  cec::vector<std::uint64_t> expected(vertices), dist(vertices);
+
+  using entry = std::pair<std::uint64_t, std::uint32_t>;
+  const auto push_heap = [](auto& q, std::uint64_t d, std::uint32_t v) { q.push(entry(d, v)); };
+  const auto pop_heap = [](auto& q) {
+    const auto top = q.top();
+    q.pop();
+    return top;
+  };
+  const auto push_keyed = [](auto& q, std::uint64_t d, std::uint32_t v) { q.push(d, v); };
+  const auto pop_keyed = [](auto& q) {
+    const entry top(q.top_key(), q.top());
+    q.pop();
+    return top;
+  };
+
+  cec::dary_heap<entry, 2, std::greater<>> binary;
+  bench::report(group, "binary dary_heap<2>", bench::ns_per_item(edges, [&] {
+                  dijkstra(g, binary, expected, push_heap, pop_heap);
+                }));
+  cec::dary_heap<entry, 4, std::greater<>> quaternary;
+  bench::report(group, "dary_heap<4>", bench::ns_per_item(edges, [&] {
+                  dijkstra(g, quaternary, dist, push_heap, pop_heap);
+                }));
+  cec::radix_heap<std::uint64_t, std::uint32_t> radix;
+  bench::report(group, "radix_heap", bench::ns_per_item(edges, [&] {
+                  radix.clear();
+                  dijkstra(g, radix, dist, push_keyed, pop_keyed);
+                }));
+  if (dist != expected) {
+    std::printf("radix_heap distances differ\n");
+  }
+  cec::bucket_queue<std::uint32_t> buckets(max_weight);
+  bench::report(group, "bucket_queue", bench::ns_per_item(edges, [&] {
+                  buckets.clear();
+                  dijkstra(g, buckets, dist, push_keyed, pop_keyed);
+                }));
+  if (dist != expected) {
+    std::printf("bucket_queue distances differ\n");
+  }
+}
+
+int
+main()
+{
+  run("1M vertices, weights <= 255", 1u << 20, 255);
+  run("1M vertices, weights <= 64K", 1u << 20, 65535);
+  run("64K vertices, weights <= 255", 1u << 16, 255);
+}
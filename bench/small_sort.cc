@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "bench.h"
+#include "constexpr_containers/small_sort.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Sorts many independent runs of n elements, the shape of per-node or per-bucket sorts in a hot
+// loop. Each repetition first restores the unsorted input
+template<typename T, typename Sort>
+double
+run(const cec::vector<T>& input, std::size_t n, cec::vector<T>& work, Sort sort)
+{
+  return bench::ns_per_item(input.size() / n, [&] {
+    std::copy(input.begin(), input.end(), work.begin());
+    for (std::size_t i = 0; i + n <= work.size(); i += n) {
+      sort(work.data() + i, work.data() + i + n);
+    }
+    bench::do_not_optimize(work[0]);
+  });
+}
+
+template<typename T>
+void
+insertion_sort(T* first, T* last)
+{
+  for (auto* it = first + 1; it < last; ++it) {
+    const T value = *it;
+    auto* hole = it;
+    for (; hole != first and value < hole[-1]; --hole) {
+      *hole = hole[-1];
+    }
+    *hole = value;
+  }
+}
+
+template<typename T>
+void
+run_type(const char* type, std::mt19937_64& rng)
+{
+  const std::size_t total = std::size_t{ 1 } << 20;
+  cec::vector<T> input(total);
+  for (auto& x : input) {
+    x = static_cast<T>(rng() % 1000000);
+  }
+  cec::vector<T> work(total);
+
+  for (std::size_t n : { 4, 8, 12, 16, 24, 32 }) {
+    char group[32];
+    std::snprintf(group, sizeof(group), "%s x %zu (per run)", type, n);
+    bench::report(group, "insertion sort", run(input, n, work, insertion_sort<T>));
+    bench::report(group, "std::sort", run(input, n, work, [](T* f, T* l) { std::sort(f, l); }));
+    bench::report(
+      group, "small_sort", run(input, n, work, [](T* f, T* l) { cec::small_sort(f, l); }));
+  }
+}
+
+int
+main()
+{
+  std::mt19937_64 rng(42);
+  run_type<std::int32_t>("int32", rng);
+  run_type<float>("float", rng);
+  run_type<std::uint64_t>("uint64", rng);
+}
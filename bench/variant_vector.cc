@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "bench.h"
+#include "constexpr_containers/variant_vector.h"
+
+namespace cec = constexpr_containers;
+
+struct small
+{
+  std::uint64_t a;
+};
+struct medium
+{
+  double x, y;
+};
+struct large
+{
+  double m[6];
+};
+
+struct weigh
+{
+  double operator()(const small& s) const { return double(s.a); }
+  double operator()(const medium& m) const { return m.x * m.y; }
+  double operator()(const large& l) const { return l.m[0] + l.m[5]; }
+};
+
+int
+main()
+{
+  const std::size_t n = std::size_t{ 1 } << 22;
+  std::vector<std::variant<small, medium, large>> variants;
+  cec::variant_vector<small, medium, large> columns;
+  std::mt19937 rng(8);
+  for (std::size_t i = 0; i < n; ++i) {
+    // Mostly small elements, which a variant pads to the size of the large ones
+    const auto r = rng() % 10;
+    const auto x = double(rng() % 64);
+    if (r < 7) {
+      variants.emplace_back(small{ i });
+      columns.push_back(small{ i });
+    } else if (r < 9) {
+      variants.emplace_back(medium{ x, x });
+      columns.push_back(medium{ x, x });
+    } else {
+      variants.emplace_back(large{ { x, 0, 0, 0, 0, x } });
+      columns.push_back(large{ { x, 0, 0, 0, 0, x } });
+    }
+  }
+  std::printf("bytes per element: vector<variant> %zu, variant_vector %.1f\n",
+              sizeof(variants[0]),
+              double(columns.column<small>().size_bytes() + columns.column<medium>().size_bytes() +
+                     columns.column<large>().size_bytes() + n * 4) /
+                double(n));
+
+  double sum = 0;
+  bench::report("4M elements, visit", "vector<variant>", bench::ns_per_item(n, [&] {
+                  for (const auto& v : variants) {
+                    sum += std::visit(weigh{}, v);
+                  }
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("4M elements, visit", "variant_vector for_each", bench::ns_per_item(n, [&] {
+                  std::as_const(columns).for_each([&](const auto& e) { sum += weigh{}(e); });
+                  bench::do_not_optimize(sum);
+                }));
+  bench::report("4M elements, visit", "variant_vector visit_all", bench::ns_per_item(n, [&] {
+                  std::as_const(columns).visit_all([&](const auto& e) { sum += weigh{}(e); });
+                  bench::do_not_optimize(sum);
+                }));
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace constexpr_containers {
+
+template<typename Iterator>
+using iterator_value_t = typename std::iterator_traits<Iterator>::value_type;
+
+// Contains algorithms useful for container classes. algorithm.h includes this header along with
+// make_range.
+//
+// Synopsis:
+//
+// less
+//   Like std::less<>, the default comparison of the library
+// zip_transform(dst, fst, fst_end, [snd, third, rest...], n-ary op)
+//   Applies op on each element in the specified ranges, if snd, third, etc are
+//   at least as long as fst..fst_end, inserting results into dst
+// zip_foreach(fst, fst_end, [snd, third, rest...], n-ary op)
+//   Applies op on each element in the specified ranges, if snd, third, etc are
+//   at least as long as fst..fst_end
+// uninitialized_copy(src, src_end, dst)
+//   Like std::uninitialized_copy, but supports a custom allocator
+// uninitialized_move(src, src_end, dst)
+//   Like std::uninitialized_move, but supports a custom allocator
+// uninitialized_move_if_noexcept(src, src_end, dst)
+//   Like the above but with move_if_noexcept
+//
+// *_launder
+//   Like the above, but where the pointers in src..src_end are laundered
+// destroy(first, last, alloc)
+//   Like std::destroy, but supports a custom allocator
+// merge_adaptive(first, middle, last, comp, scratch, scratch_size, alloc)
+//   Stable merge of the sorted ranges first..middle and middle..last, like std::inplace_merge,
+//   but with scratch pointing to uninitialized storage for scratch_size elements instead of an
+//   allocated buffer. Without enough scratch it splits and rotates, in O(n log n)
+// stable_partition_adaptive(first, last, pred, scratch, scratch_size, alloc)
+//   Like std::stable_partition, with the same scratch storage scheme as merge_adaptive
+
+// Like std::less<>, so that defaults need not pull in <functional>
+struct less
+{
+  using is_transparent = void;
+
+  template<typename T, typename U>
+  [[nodiscard]] constexpr //
+    bool
+    operator()(T&& a, U&& b) //
+    const noexcept(noexcept(std::forward<T>(a) < std::forward<U>(b)))
+  {
+    return std::forward<T>(a) < std::forward<U>(b);
+  }
+};
+
+template<std::input_or_output_iterator OutputIt,
+         std::input_iterator FstIt,
+         typename Op,
+         std::input_iterator... RestIt>
+constexpr //
+  OutputIt
+  zip_transform(FstIt fst, FstIt fst_end, OutputIt dst, Op op, RestIt... rest)
+{
+  for (; fst != fst_end; ++dst, ++fst, (++rest, ...)) {
+    *dst = op(*fst, *rest...);
+  }
+  return dst;
+}
+
+template<std::input_iterator FstIt, typename Op, std::input_iterator... RestIt>
+constexpr //
+  void
+  zip_foreach(FstIt fst, FstIt fst_end, Op op, RestIt... rest)
+{
+  for (; fst != fst_end; ++fst, (++rest, ...)) {
+    op(*fst, *rest...);
+  }
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_copy(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(alloc, dst, *src);
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_move(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*src));
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_move_if_noexcept(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(alloc, dst, std::move_if_noexcept(*src));
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_copy_launder(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(alloc, dst, *std::launder(src));
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_move_launder(InputIt src, InputIt src_end, OutputIt dst, Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*std::launder(src)));
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_move_if_noexcept_launder(InputIt src,
+                                         InputIt src_end,
+                                         OutputIt dst,
+                                         Allocator alloc)
+{
+  for (; src != src_end; ++src, ++dst) {
+    std::allocator_traits<Allocator>::construct(
+      alloc, dst, std::move_if_noexcept(*std::launder(src)));
+  }
+  return dst;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  move_if_noexcept_launder_backward(InputIt src, InputIt src_end, OutputIt dst_end)
+{
+  for (; src != src_end; --src_end, --dst_end) {
+    --src_end;
+    --dst_end;
+    *dst_end = std::move_if_noexcept(*std::launder(src_end));
+  }
+  return dst_end;
+}
+
+template<std::input_iterator InputIt,
+         std::input_or_output_iterator OutputIt,
+         typename Allocator = std::allocator<iterator_value_t<OutputIt>>>
+constexpr //
+  OutputIt
+  uninitialized_move_if_noexcept_launder_backward(InputIt src,
+                                                  InputIt src_end,
+                                                  OutputIt dst_end,
+                                                  Allocator alloc)
+{
+  for (; src != src_end; --src_end, --dst_end) {
+    --src_end;
+    --dst_end;
+    std::allocator_traits<Allocator>::construct(
+      alloc, dst_end, std::move_if_noexcept(*std::launder(src_end)));
+  }
+  return dst_end;
+}
+
+template<std::input_iterator It, typename Allocator = std::allocator<iterator_value_t<It>>>
+constexpr //
+  void
+  destroy(It first, It last, Allocator alloc) //
+  noexcept
+{
+  for (; first != last; ++first) {
+    std::allocator_traits<Allocator>::destroy(alloc, first);
+  }
+}
+
+template<std::random_access_iterator It,
+         typename Compare,
+         std::random_access_iterator Scratch,
+         typename Allocator = std::allocator<iterator_value_t<It>>>
+constexpr //
+  void
+  merge_adaptive(It first,
+                 It middle,
+                 It last,
+                 Compare comp,
+                 Scratch scratch,
+                 std::size_t scratch_size,
+                 Allocator alloc)
+{
+  const auto len1 = static_cast<std::size_t>(middle - first);
+  const auto len2 = static_cast<std::size_t>(last - middle);
+  if (len1 == 0 or len2 == 0) {
+    return;
+  }
+
+  if (len1 <= len2 and len1 <= scratch_size) {
+    // Move the left run out of the way and merge forwards
+    auto scratch_end = uninitialized_move(first, middle, scratch, alloc);
+    auto a = scratch;
+    auto b = middle;
+    for (; a != scratch_end and b != last; ++first) {
+      *first = comp(*b, *a) ? std::move(*b++) : std::move(*a++);
+    }
+    std::move(a, scratch_end, first);
+    destroy(scratch, scratch_end, alloc);
+    return;
+  }
+  if (len2 <= scratch_size) {
+    // Move the right run out of the way and merge backwards
+    auto scratch_end = uninitialized_move(middle, last, scratch, alloc);
+    auto a = middle;
+    auto b = scratch_end;
+    while (a != first and b != scratch) {
+      *--last = comp(*(b - 1), *(a - 1)) ? std::move(*--a) : std::move(*--b);
+    }
+    std::move_backward(scratch, b, last);
+    destroy(scratch, scratch_end, alloc);
+    return;
+  }
+  if (len1 + len2 == 2) {
+    if (comp(*middle, *first)) {
+      std::iter_swap(first, middle);
+    }
+    return;
+  }
+
+  // Split the longer run in half, find where its middle lands in the other, and swap the parts
+  // in between, leaving two independent merges
+  It cut1 = first;
+  It cut2 = middle;
+  if (len1 > len2) {
+    cut1 += len1 / 2;
+    cut2 = std::lower_bound(middle, last, *cut1, comp);
+  } else {
+    cut2 += len2 / 2;
+    cut1 = std::upper_bound(first, middle, *cut2, comp);
+  }
+  const It new_middle = std::rotate(cut1, middle, cut2);
+  merge_adaptive(first, cut1, new_middle, comp, scratch, scratch_size, alloc);
+  merge_adaptive(new_middle, cut2, last, comp, scratch, scratch_size, alloc);
+}
+
+template<std::random_access_iterator It,
+         typename Pred,
+         std::random_access_iterator Scratch,
+         typename Allocator = std::allocator<iterator_value_t<It>>>
+constexpr //
+  It
+  stable_partition_adaptive(It first,
+                            It last,
+                            Pred pred,
+                            Scratch scratch,
+                            std::size_t scratch_size,
+                            Allocator alloc)
+{
+  const auto len = static_cast<std::size_t>(last - first);
+  if (len <= scratch_size) {
+    // Compact the accepted elements in place and park the rejected ones in scratch
+    auto out = first;
+    auto rejected = scratch;
+    for (auto it = first; it != last; ++it) {
+      if (pred(*it)) {
+        if (out != it) {
+          *out = std::move(*it);
+        }
+        ++out;
+      } else {
+        std::allocator_traits<Allocator>::construct(alloc, rejected++, std::move(*it));
+      }
+    }
+    std::move(scratch, rejected, out);
+    destroy(scratch, rejected, alloc);
+    return out;
+  }
+  if (len == 1) {
+    return pred(*first) ? last : first;
+  }
+
+  const It middle = first + len / 2;
+  const It left = stable_partition_adaptive(first, middle, pred, scratch, scratch_size, alloc);
+  const It right = stable_partition_adaptive(middle, last, pred, scratch, scratch_size, alloc);
+  return std::rotate(left, middle, right);
+}
+
+} // namespace constexpr_containers
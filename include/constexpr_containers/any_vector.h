@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "constexpr_containers/exceptions.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Contiguous vector of elements whose type is only known at runtime, described by a
+// type_descriptor, such as arrays handed over by plugins.
+//
+// Synopsis:
+//
+// type_descriptor
+//   Size, alignment, type_info and bulk construct / copy / move / destroy functions of a type,
+//   each working on n contiguous elements. descriptor_of<T> describes T; plugins can fill in
+//   their own
+// any_vector<Allocator>(descriptor)
+//   Elements of the descriptor's type, back to back: element i lives at data() + i * size.
+//   Growth follows vector_base, doubling plus one; trivially relocatable types grow by copying
+//   bytes, others by one move and one destroy call over all the elements
+// push_back(element), append(elements, n), resize(n), erase(first, last)
+//   Bulk operations call the descriptor once per call, not once per element
+// get<T>(i), as_span<T>()
+//   Typed access, for callers that know the type; the type is checked against the descriptor
+//
+// Types cannot be aligned beyond std::max_align_t. Unlike the rest of the library, any_vector is
+// not constexpr, as it reaches elements through void*.
+
+struct type_descriptor
+{
+  std::size_t size;
+  std::size_t alignment;
+  const std::type_info* type;
+  // Whether moving then destroying an element amounts to copying its bytes
+  bool trivially_relocatable;
+  // All of these work on n elements; dst is uninitialized storage, and is left so if they throw.
+  // copy is null for move-only types
+  void (*construct)(void* dst, std::size_t n);
+  void (*copy)(const void* src, void* dst, std::size_t n);
+  void (*move)(void* src, void* dst, std::size_t n);
+  void (*destroy)(void* first, std::size_t n);
+
+  // trivially_relocatable may be set for types that are not trivially copyable but whose moves
+  // only copy bytes, such as std::unique_ptr
+  template<typename T>
+  [[nodiscard]] static constexpr //
+    type_descriptor
+    of(bool trivially_relocatable = std::is_trivially_copyable_v<T>) //
+    noexcept
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Over-aligned types are not supported.");
+    void (*copy)(const void*, void*, std::size_t) = nullptr;
+    if constexpr (std::is_copy_constructible_v<T>) {
+      copy = [](const void* src, void* dst, std::size_t n) {
+        std::uninitialized_copy_n(static_cast<const T*>(src), n, static_cast<T*>(dst));
+      };
+    }
+    return {
+      sizeof(T),
+      alignof(T),
+      &typeid(T),
+      trivially_relocatable,
+      [](void* dst, std::size_t n) {
+        std::uninitialized_value_construct_n(static_cast<T*>(dst), n);
+      },
+      copy,
+      [](void* src, void* dst, std::size_t n) {
+        std::uninitialized_move_n(static_cast<T*>(src), n, static_cast<T*>(dst));
+      },
+      [](void* first, std::size_t n) { std::destroy_n(static_cast<T*>(first), n); },
+    };
+  }
+};
+
+template<typename T>
+inline constexpr type_descriptor descriptor_of = type_descriptor::of<T>();
+
+template<typename Allocator = std::allocator<std::byte>>
+struct any_vector
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  // The unit of storage, aligned for any supported type
+  struct alignas(std::max_align_t) unit
+  {
+    std::byte bytes[alignof(std::max_align_t)];
+  };
+
+  using UnitAllocator = typename AllocTraitsT::template rebind_alloc<unit>;
+
+public:
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  const type_descriptor* m_type;
+  // Only reserved, as units are implicit-lifetime: elements are constructed in its capacity
+  vector_base<unit, UnitAllocator> m_storage;
+  size_type m_size = 0;
+  // Cached, to keep a division out of every push
+  size_type m_capacity = 0;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  // The descriptor must outlive the vector
+  explicit //
+    any_vector(const type_descriptor& type, const Allocator& alloc = Allocator())
+    : m_type(&type)
+    , m_storage(UnitAllocator(alloc))
+  {}
+
+  any_vector(const any_vector& other)
+    : any_vector(*other.m_type, other.m_storage.get_allocator())
+  {
+    append(other.data(), other.size());
+  }
+
+  any_vector(any_vector&& other) noexcept
+    : m_type(other.m_type)
+    , m_storage(std::move(other.m_storage))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_capacity(std::exchange(other.m_capacity, 0))
+  {}
+
+  any_vector& operator=(any_vector other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~any_vector() { clear(); }
+
+  void swap(any_vector& other) noexcept
+  {
+    std::swap(m_type, other.m_type);
+    std::swap(m_storage, other.m_storage);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] const type_descriptor& type() /**/ const noexcept { return *m_type; }
+  [[nodiscard]] size_type size() /***************/ const noexcept { return m_size; }
+  [[nodiscard]] bool empty() /*******************/ const noexcept { return m_size == 0; }
+  [[nodiscard]] void* data() /*******************/ noexcept { return bytes(); }
+  [[nodiscard]] const void* data() /*************/ const noexcept { return bytes(); }
+
+  [[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
+
+  [[nodiscard]] void* operator[](size_type i) noexcept { return bytes() + i * m_type->size; }
+  [[nodiscard]] const void* operator[](size_type i) const noexcept
+  {
+    return bytes() + i * m_type->size;
+  }
+
+  template<typename T>
+  [[nodiscard]] //
+    T&
+    get(size_type i)
+  {
+    return as_span<T>()[i];
+  }
+
+  template<typename T>
+  [[nodiscard]] //
+    const T&
+    get(size_type i) //
+    const
+  {
+    return as_span<T>()[i];
+  }
+
+  template<typename T>
+  [[nodiscard]] //
+    std::span<T>
+    as_span()
+  {
+    check_type<T>();
+    return std::span<T>(std::launder(static_cast<T*>(data())), m_size);
+  }
+
+  template<typename T>
+  [[nodiscard]] //
+    std::span<const T>
+    as_span() //
+    const
+  {
+    check_type<T>();
+    return std::span<const T>(std::launder(static_cast<const T*>(data())), m_size);
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  void reserve(size_type new_cap)
+  {
+    if (new_cap <= capacity()) {
+      return;
+    }
+    const auto units = (new_cap * m_type->size + sizeof(unit) - 1) / sizeof(unit);
+    vector_base<unit, UnitAllocator> storage(m_storage.get_allocator());
+    storage.reserve(units);
+    auto* const dst = reinterpret_cast<std::byte*>(std::to_address(storage.data()));
+    if (m_type->trivially_relocatable) {
+      // memcpy must not see the null data() of an unallocated vector
+      if (m_size != 0) {
+        std::memcpy(dst, data(), m_size * m_type->size);
+      }
+    } else {
+      m_type->move(data(), dst, m_size);
+      m_type->destroy(data(), m_size);
+    }
+    std::swap(m_storage, storage);
+    m_capacity = m_storage.capacity() * sizeof(unit) / m_type->size;
+  }
+
+  // Copies n elements from src, which may not alias the vector
+  void append(const void* src, size_type n)
+  {
+    if (n != 0 and not m_type->copy) {
+      throw_logic_error("any_vector cannot copy a move-only type.");
+    }
+    grow_for(n);
+    m_type->copy(src, end(), n);
+    m_size += n;
+  }
+
+  // Moves n elements from src, which are left moved-from
+  void append_moved(void* src, size_type n)
+  {
+    grow_for(n);
+    m_type->move(src, end(), n);
+    m_size += n;
+  }
+
+  void push_back(const void* element) { append(element, 1); }
+
+  template<typename T, typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    check_type<T>();
+    grow_for(1);
+    auto* element = ::new (end()) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *element;
+  }
+
+  void pop_back() noexcept
+  {
+    --m_size;
+    m_type->destroy(end(), 1);
+  }
+
+  // New elements are value-initialized
+  void resize(size_type count)
+  {
+    if (count > m_size) {
+      grow_for(count - m_size);
+      m_type->construct(end(), count - m_size);
+      m_size = count;
+    } else {
+      m_type->destroy((*this)[count], m_size - count);
+      m_size = count;
+    }
+  }
+
+  // If a move throws, the vector keeps the elements in front of the first one left unmoved
+  void erase(size_type first, size_type last)
+  {
+    const auto gap = last - first;
+    if (gap == 0) {
+      return;
+    }
+    m_type->destroy((*this)[first], gap);
+    if (m_type->trivially_relocatable) {
+      std::memmove((*this)[first], (*this)[last], (m_size - last) * m_type->size);
+    } else {
+      // Moves the tail down gap elements at a time, so that sources and destinations never
+      // overlap
+      auto src = last;
+      try {
+        for (; src < m_size; src += gap) {
+          const auto n = std::min(gap, m_size - src);
+          m_type->move((*this)[src], (*this)[src - gap], n);
+          m_type->destroy((*this)[src], n);
+        }
+      } catch (...) {
+        // The gap elements in front of src are destroyed, so those from src on cannot stay
+        m_type->destroy((*this)[src], m_size - src);
+        m_size = src - gap;
+        throw;
+      }
+    }
+    m_size -= gap;
+  }
+
+  // Keeps the capacity
+  void clear() noexcept
+  {
+    m_type->destroy(data(), m_size);
+    m_size = 0;
+  }
+
+private:
+  [[nodiscard]] std::byte* bytes() noexcept
+  {
+    return reinterpret_cast<std::byte*>(std::to_address(m_storage.data()));
+  }
+  [[nodiscard]] const std::byte* bytes() const noexcept
+  {
+    return reinterpret_cast<const std::byte*>(std::to_address(m_storage.data()));
+  }
+  [[nodiscard]] void* end() noexcept { return (*this)[m_size]; }
+
+  void grow_for(size_type n)
+  {
+    if (m_size + n > m_capacity) {
+      reserve(std::max(m_size + n, m_size * 2 + 1));
+    }
+  }
+
+  template<typename T>
+  void check_type() const
+  {
+    if (*m_type->type != typeid(T)) {
+      throw_invalid_argument("any_vector accessed with the wrong type.");
+    }
+  }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,413 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+#include "constexpr_containers/views.h"
+
+namespace constexpr_containers {
+
+// Entity-component storage grouped by archetype: all entities with the same set of components
+// share one table, holding one vector_base column per component, so that iterating over some
+// components of many entities reads each column sequentially.
+//
+// Synopsis:
+//
+// basic_archetype_store<Allocator, Components...>, archetype_store<Components...>
+//   Components are known at compile time, up to 64 of them, and must be distinct types
+// create(components...)
+//   New entity with the given components, returns its id
+// add(entity, component), remove<C>(entity)
+//   Moves the entity to the table of its new signature: one push per component on one side and
+//   one swap with the last row on the other, independent of the number of entities. Each table
+//   remembers its neighbour with one component more or less, so finding it is independent of
+//   the number of tables too, once that move has been made
+// get<C>(entity), has<C>(entity), destroy(entity)
+// each<Cs...>(f)
+//   f(Cs&...) for every entity with at least components Cs, table by table
+// each_chunk<Cs...>(f)
+//   f(entities, columns...) for every matching table, as spans
+// parallel_each<Cs...>(threads, f)
+//   Like each, splitting the matching tables into chunks of chunk_rows entities spread over
+//   threads. f must be safe to call concurrently on different entities
+//
+// Entity ids of destroyed entities are reused. Everything but parallel_each on more than one
+// thread is constexpr.
+
+template<typename Allocator, typename... Components>
+struct basic_archetype_store
+{
+  static_assert(sizeof...(Components) <= 64, "Signatures are 64-bit masks.");
+
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  template<typename U>
+  using rebind = vector_base<U, typename AllocTraitsT::template rebind_alloc<U>>;
+
+public:
+  using entity_type = std::uint32_t;
+  using signature_type = std::uint64_t;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr size_type chunk_rows = 4096;
+
+  template<typename C>
+  static constexpr std::size_t component_index = [] {
+    constexpr bool match[] = { std::is_same_v<C, Components>... };
+    std::size_t i = 0;
+    while (i < sizeof...(Components) and not match[i]) {
+      ++i;
+    }
+    return i;
+  }();
+
+  template<typename... Cs>
+  static constexpr signature_type signature_of =
+    ((signature_type{ 1 } << component_index<Cs>) | ... | 0);
+
+private:
+  static constexpr auto npos = std::numeric_limits<size_type>::max();
+
+  struct table
+  {
+    signature_type signature = 0;
+    rebind<entity_type> entities;
+    // Only the columns of the components in signature are used
+    std::tuple<rebind<Components>...> columns;
+    // Per component, 1 + the index of the table whose signature differs by that component alone,
+    // 0 until known
+    std::array<size_type, sizeof...(Components)> edges{};
+  };
+
+  struct location
+  {
+    size_type table = npos;
+    size_type row = 0;
+  };
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  rebind<table> m_tables;
+  // Indexed by entity
+  rebind<location> m_locations;
+  rebind<entity_type> m_free;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr basic_archetype_store() = default;
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr //
+    size_type
+    size() //
+    const noexcept
+  {
+    return m_locations.size() - m_free.size();
+  }
+
+  [[nodiscard]] constexpr size_type table_count() const noexcept { return m_tables.size(); }
+
+  [[nodiscard]] constexpr //
+    bool
+    alive(entity_type e) //
+    const noexcept
+  {
+    return e < m_locations.size() and m_locations[e].table != npos;
+  }
+
+  [[nodiscard]] constexpr //
+    signature_type
+    signature(entity_type e) //
+    const noexcept
+  {
+    return m_tables[m_locations[e].table].signature;
+  }
+
+  template<typename C>
+  [[nodiscard]] constexpr //
+    bool
+    has(entity_type e) //
+    const noexcept
+  {
+    return signature(e) & signature_of<C>;
+  }
+
+  // The entity must have a C
+  template<typename C>
+  [[nodiscard]] constexpr //
+    C&
+    get(entity_type e) //
+    noexcept
+  {
+    const auto [t, row] = m_locations[e];
+    return column<C>(m_tables[t])[row];
+  }
+
+  template<typename C>
+  [[nodiscard]] constexpr //
+    const C&
+    get(entity_type e) //
+    const noexcept
+  {
+    const auto [t, row] = m_locations[e];
+    return column<C>(m_tables[t])[row];
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename... Cs>
+  constexpr //
+    entity_type
+    create(Cs&&... components)
+  {
+    constexpr auto signature = signature_of<std::remove_cvref_t<Cs>...>;
+    static_assert(std::popcount(signature) == sizeof...(Cs), "Components must be distinct.");
+
+    entity_type e;
+    if (m_free.empty()) {
+      e = static_cast<entity_type>(m_locations.size());
+      m_locations.emplace_back();
+    } else {
+      e = m_free.back();
+      m_free.pop_back();
+    }
+    const auto t = table_for(signature);
+    auto& dst = m_tables[t];
+    (column<std::remove_cvref_t<Cs>>(dst).push_back(std::forward<Cs>(components)), ...);
+    m_locations[e] = { t, dst.entities.size() };
+    dst.entities.push_back(e);
+    return e;
+  }
+
+  // Adds or replaces the component C of e
+  template<typename C>
+  constexpr //
+    void
+    add(entity_type e, C&& component)
+  {
+    using T = std::remove_cvref_t<C>;
+    if (has<T>(e)) {
+      get<T>(e) = std::forward<C>(component);
+      return;
+    }
+    const auto t = neighbour(m_locations[e].table, component_index<T>);
+    column<T>(m_tables[t]).push_back(std::forward<C>(component));
+    move_entity(e, t);
+  }
+
+  template<typename C>
+  constexpr //
+    void
+    remove(entity_type e)
+  {
+    if (has<C>(e)) {
+      move_entity(e, neighbour(m_locations[e].table, component_index<C>));
+    }
+  }
+
+  constexpr //
+    void
+    destroy(entity_type e)
+  {
+    const auto [t, row] = m_locations[e];
+    erase_row(m_tables[t], row);
+    m_locations[e].table = npos;
+    m_free.push_back(e);
+  }
+
+  // Keeps the tables and their capacity
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    for (auto& t : m_tables) {
+      t.entities.clear();
+      std::apply([](auto&... columns) { (columns.clear(), ...); }, t.columns);
+    }
+    m_locations.clear();
+    m_free.clear();
+  }
+
+  /////////////
+  // Queries //
+  /////////////
+
+  template<typename... Cs, typename F>
+  constexpr //
+    void
+    each_chunk(F&& f)
+  {
+    constexpr auto required = signature_of<Cs...>;
+    for (auto& t : m_tables) {
+      if ((t.signature & required) == required and not t.entities.empty()) {
+        f(std::span<const entity_type>(as_span(t.entities)), as_span(column<Cs>(t))...);
+      }
+    }
+  }
+
+  template<typename... Cs, typename F>
+  constexpr //
+    void
+    each(F&& f)
+  {
+    each_chunk<Cs...>([&](std::span<const entity_type> entities, std::span<Cs>... columns) {
+      for (size_type row = 0; row < entities.size(); ++row) {
+        f(columns[row]...);
+      }
+    });
+  }
+
+  template<typename... Cs, typename F>
+  constexpr //
+    void
+    parallel_each(unsigned threads, F&& f)
+  {
+    constexpr auto required = signature_of<Cs...>;
+    // (table, first row) of every chunk
+    rebind<std::pair<size_type, size_type>> chunks;
+    for (size_type t = 0; t < m_tables.size(); ++t) {
+      if ((m_tables[t].signature & required) == required) {
+        for (size_type row = 0; row < m_tables[t].entities.size(); row += chunk_rows) {
+          chunks.emplace_back(t, row);
+        }
+      }
+    }
+    threads =
+      static_cast<unsigned>(std::clamp<size_type>(chunks.size(), 1, std::max(threads, 1u)));
+    parallel_for(threads, [&](unsigned thread) {
+      for (auto c = size_type{ thread }; c < chunks.size(); c += threads) {
+        auto& t = m_tables[chunks[c].first];
+        const auto first = chunks[c].second;
+        const auto last = std::min(first + chunk_rows, t.entities.size());
+        for (auto row = first; row < last; ++row) {
+          f(column<Cs>(t)[row]...);
+        }
+      }
+    });
+  }
+
+private:
+  template<typename C>
+  [[nodiscard]] static constexpr //
+    rebind<C>&
+    column(table& t) //
+    noexcept
+  {
+    static_assert(component_index<C> < sizeof...(Components), "Unknown component.");
+    return std::get<component_index<C>>(t.columns);
+  }
+
+  template<typename C>
+  [[nodiscard]] static constexpr //
+    const rebind<C>&
+    column(const table& t) //
+    noexcept
+  {
+    static_assert(component_index<C> < sizeof...(Components), "Unknown component.");
+    return std::get<component_index<C>>(t.columns);
+  }
+
+  // Index of the table of this signature, created if needed
+  [[nodiscard]] constexpr //
+    size_type
+    table_for(signature_type signature)
+  {
+    for (size_type t = 0; t < m_tables.size(); ++t) {
+      if (m_tables[t].signature == signature) {
+        return t;
+      }
+    }
+    m_tables.emplace_back();
+    m_tables.back().signature = signature;
+    return m_tables.size() - 1;
+  }
+
+  // Index of the table with component i added to or removed from those of table t, following
+  // the edge between them after the first time
+  [[nodiscard]] constexpr //
+    size_type
+    neighbour(size_type t, std::size_t i)
+  {
+    if (m_tables[t].edges[i] == 0) {
+      const auto next = table_for(m_tables[t].signature ^ (signature_type{ 1 } << i));
+      m_tables[t].edges[i] = next + 1;
+      m_tables[next].edges[i] = t + 1;
+    }
+    return m_tables[t].edges[i] - 1;
+  }
+
+  // Moves the components of e that the table t has into it, after any component t has and e
+  // had not was pushed
+  constexpr //
+    void
+    move_entity(entity_type e, size_type t)
+  {
+    const auto [from, row] = m_locations[e];
+    auto& src = m_tables[from];
+    auto& dst = m_tables[t];
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((dst.signature & src.signature & (signature_type{ 1 } << I) ?
+          std::get<I>(dst.columns).push_back(std::move(std::get<I>(src.columns)[row])) :
+          void()),
+       ...);
+    }(std::index_sequence_for<Components...>());
+    m_locations[e] = { t, dst.entities.size() };
+    dst.entities.push_back(e);
+    erase_row(src, row);
+  }
+
+  // Fills the hole with the last row
+  constexpr //
+    void
+    erase_row(table& t, size_type row)
+  {
+    const auto last = t.entities.size() - 1;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      const auto erase = [&](auto& column) {
+        if (row != last) {
+          column[row] = std::move(column[last]);
+        }
+        column.pop_back();
+      };
+      ((t.signature & (signature_type{ 1 } << I) ? erase(std::get<I>(t.columns)) : void()), ...);
+    }(std::index_sequence_for<Components...>());
+    if (row != last) {
+      t.entities[row] = t.entities[last];
+      m_locations[t.entities[row]].row = row;
+    }
+    t.entities.pop_back();
+  }
+};
+
+template<typename... Components>
+using archetype_store = basic_archetype_store<std::allocator<std::byte>, Components...>;
+
+} // namespace constexpr_containers
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "constexpr_containers/io.h"
+#include "constexpr_containers/uring.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Loads many files, or segments of files, at once: every read is issued up front, so loading
+// takes about as long as the aggregate bandwidth allows rather than the sum of each file's
+// latency. Reads land in the spare capacity of their vector_base, reserved when they are
+// enqueued, which adopts them with append_uninitialized once they complete.
+//
+// Synopsis:
+//
+// async_loader(backend, threads)
+//   With io_uring, all reads in flight at once, as many as the ring holds, from the thread that
+//   calls poll() and wait(). Otherwise, threads worker threads with blocking pread
+// enqueue(fd, out, bytes = all, offset = 0)
+//   Reserves room in out, then starts reading bytes bytes from offset (by default, to the end of
+//   the file) into it. Returns an id for the completion. out must neither be touched nor be the
+//   target of another read until it completes
+// poll(op), wait(op)
+//   Call op(id, elements, error) for each completed read, on the calling thread, after
+//   appending the elements read, fewer than requested at end of file. On error, nothing is
+//   appended and error says why, with io_error when the file ends inside an element. poll()
+//   returns right away, wait() once every read enqueued so far is done, and both return the
+//   number of completions. op may enqueue more reads
+//
+// Ids count enqueued reads from 0, and restart from 0 once every read enqueued so far has been
+// reported. The destructor waits for reads in flight, without calling anyone.
+
+struct async_loader
+{
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  explicit async_loader(io_backend backend = io_backend::automatic, unsigned threads = 8)
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    if (backend == io_backend::io_uring or
+        (backend == io_backend::automatic and uring::available())) {
+      m_ring = std::make_unique<uring>(ring_entries);
+      m_slots.resize(m_ring->entries());
+      for (unsigned slot = 0; slot < m_ring->entries(); ++slot) {
+        m_free_slots.push_back(slot);
+      }
+      return;
+    }
+#endif
+    if (backend == io_backend::io_uring) {
+      throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                              "io_uring");
+    }
+    threads = std::max(threads, 1U);
+    m_workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+      m_workers.emplace_back([this] { work(); });
+    }
+  }
+
+  async_loader(const async_loader&) = delete;
+  async_loader& operator=(const async_loader&) = delete;
+
+  ~async_loader()
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    if (m_ring) {
+      // The kernel may still write to the vectors
+      while (m_ring->in_flight() > 0) {
+        m_ring->submit(1);
+        m_ring->reap([](std::uint64_t, std::int32_t) {});
+      }
+      return;
+    }
+#endif
+    {
+      const std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_work_ready.notify_all();
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] std::size_t pending() /****/ const noexcept { return m_pending; }
+
+  [[nodiscard]] //
+    bool
+    uses_io_uring() //
+    const noexcept
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    return m_ring != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename T, typename Alloc>
+  std::size_t
+  enqueue(int fd, vector_base<T, Alloc>& out, std::size_t bytes = all_bytes, off_t offset = 0)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Elements are read as bytes.");
+    if (bytes == all_bytes) {
+      // The size must be known up front to reserve
+      bytes = bytes_until_end(fd, offset);
+      if (bytes == all_bytes) {
+        throw std::invalid_argument("Reading to the end of a file of unknown size.");
+      }
+      if (bytes % sizeof(T) != 0) {
+        throw std::runtime_error("Input ends inside an element.");
+      }
+    } else if (bytes % sizeof(T) != 0) {
+      throw std::invalid_argument("Byte count is not a multiple of the element size.");
+    }
+    out.reserve(out.size() + bytes / sizeof(T));
+    advise_sequential(fd, offset, bytes);
+
+    const auto id = m_requests.size();
+    auto* const dst = reinterpret_cast<std::byte*>(std::to_address(out.data()) + out.size());
+    m_requests.push_back({ &out, &adopt<T, Alloc>, sizeof(T) });
+    try {
+      start({ id, fd, dst, bytes, offset, 0, 0 });
+    } catch (...) {
+      m_requests.pop_back();
+      throw;
+    }
+    ++m_pending;
+    return id;
+  }
+
+  template<typename Op>
+  std::size_t poll(Op op)
+  {
+    return process(op, false);
+  }
+
+  template<typename Op>
+  std::size_t wait(Op op)
+  {
+    std::size_t count = 0;
+    while (m_pending > 0) {
+      count += process(op, true);
+    }
+    return count;
+  }
+
+private:
+  static constexpr unsigned ring_entries = 64;
+
+  // Where a read goes, and how far along it is. done and error are filled in by whoever runs it
+  struct segment
+  {
+    std::size_t id;
+    int fd;
+    std::byte* dst;
+    std::size_t bytes;
+    off_t offset;
+    std::size_t done;
+    int error;
+  };
+
+  struct request
+  {
+    void* out;
+    void (*adopt)(void* out, std::size_t elements);
+    std::size_t element_size;
+  };
+
+  template<typename T, typename Alloc>
+  static void adopt(void* out, std::size_t elements)
+  {
+    // The elements are already in the spare capacity
+    static_cast<vector_base<T, Alloc>*>(out)->append_uninitialized(
+      elements, [](T*, std::size_t count) { return count; });
+  }
+
+  // Queues r for the ring or the workers. Nothing is queued if this throws
+  void start(const segment& r)
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    if (m_ring) {
+      m_waiting.push_back(r);
+      submit_waiting();
+      try {
+        m_ring->submit();
+      } catch (const std::system_error&) {
+        // r is queued all the same, and poll() and wait() submit it again, throwing if the
+        // kernel still refuses
+      }
+      return;
+    }
+#endif
+    {
+      const std::lock_guard lock(m_mutex);
+      m_reads.push_back(r);
+    }
+    m_work_ready.notify_one();
+  }
+
+  // Hands over the completed reads, waiting for at least one if wait is set, then reports them
+  template<typename Op>
+  std::size_t process(Op& op, bool wait)
+  {
+    vector_base<segment, std::allocator<segment>> completed;
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    if (m_ring) {
+      reap_ring(wait);
+      std::swap(completed, m_completed);
+    } else
+#endif
+    {
+      std::unique_lock lock(m_mutex);
+      if (wait) {
+        m_done_ready.wait(lock, [&] { return not m_completed.empty(); });
+      }
+      std::swap(completed, m_completed);
+    }
+
+    for (const auto& r : completed) {
+      const auto& request = m_requests[r.id];
+      --m_pending;
+      auto error = r.error;
+      if (error == 0 and r.done % request.element_size != 0) {
+        error = EIO;
+      }
+      const auto elements = error == 0 ? r.done / request.element_size : 0;
+      if (elements > 0) {
+        request.adopt(request.out, elements);
+      }
+      op(r.id, elements, std::error_code(error, std::generic_category()));
+      // Unless op enqueued more, every read is reported, so ids can start over
+      if (m_pending == 0) {
+        m_requests.clear();
+      }
+    }
+    return completed.size();
+  }
+
+  ////////////////////
+  // Worker threads //
+  ////////////////////
+
+  void work()
+  {
+    for (;;) {
+      segment r;
+      {
+        std::unique_lock lock(m_mutex);
+        m_work_ready.wait(lock, [&] { return m_stop or m_next_read < m_reads.size(); });
+        if (m_stop) {
+          return;
+        }
+        r = m_reads[m_next_read++];
+        if (m_next_read == m_reads.size()) {
+          m_reads.clear();
+          m_next_read = 0;
+        }
+      }
+      while (r.done < r.bytes) {
+        const auto got =
+          ::pread(r.fd, r.dst + r.done, std::min(r.bytes - r.done, io_block_bytes),
+                  r.offset + static_cast<off_t>(r.done));
+        if (got < 0 and errno == EINTR) {
+          continue;
+        }
+        if (got <= 0) {
+          r.error = got < 0 ? errno : 0;
+          break;
+        }
+        r.done += static_cast<std::size_t>(got);
+      }
+      {
+        const std::lock_guard lock(m_mutex);
+        m_completed.push_back(r);
+      }
+      m_done_ready.notify_one();
+    }
+  }
+
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  //////////////
+  // io_uring //
+  //////////////
+
+  // Each slot of the ring holds the read in flight and its iovec, which must stay put
+  struct slot
+  {
+    segment r;
+    iovec iov;
+  };
+
+  void submit_waiting()
+  {
+    while (m_next_waiting < m_waiting.size() and not m_free_slots.empty()) {
+      const auto index = m_free_slots.back();
+      auto& s = m_slots[index];
+      s.r = m_waiting[m_next_waiting];
+      const auto len = std::min(s.r.bytes - s.r.done, io_block_bytes);
+      s.iov = { s.r.dst + s.r.done, len };
+      const auto offset = static_cast<std::uint64_t>(s.r.offset) + s.r.done;
+      if (not m_ring->prepare(IORING_OP_READV, s.r.fd, &s.iov, 1, offset, index)) {
+        break;
+      }
+      m_free_slots.pop_back();
+      ++m_next_waiting;
+    }
+    if (m_next_waiting == m_waiting.size()) {
+      m_waiting.clear();
+      m_next_waiting = 0;
+    }
+  }
+
+  void reap_ring(bool wait)
+  {
+    do {
+      submit_waiting();
+      m_ring->submit(wait and m_completed.empty() ? 1 : 0);
+      m_ring->reap([&](std::uint64_t index, std::int32_t result) {
+        auto& s = m_slots[index];
+        m_free_slots.push_back(static_cast<unsigned>(index));
+        if (result == -EINTR or result == -EAGAIN) {
+          m_waiting.push_back(s.r);
+        } else if (result < 0) {
+          s.r.error = -result;
+          m_completed.push_back(s.r);
+        } else if (s.r.done += static_cast<std::size_t>(result);
+                   result > 0 and s.r.done < s.r.bytes) {
+          m_waiting.push_back(s.r);
+        } else {
+          m_completed.push_back(s.r);
+        }
+      });
+    } while (wait and m_completed.empty());
+    submit_waiting();
+    m_ring->submit();
+  }
+#endif
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  std::size_t m_pending = 0;
+  vector_base<request, std::allocator<request>> m_requests;
+  vector_base<segment, std::allocator<segment>> m_completed;
+
+  // Worker threads, sharing m_reads and m_completed under m_mutex
+  std::mutex m_mutex;
+  std::condition_variable m_work_ready;
+  std::condition_variable m_done_ready;
+  vector_base<segment, std::allocator<segment>> m_reads;
+  std::size_t m_next_read = 0;
+  bool m_stop = false;
+  vector_base<std::thread, std::allocator<std::thread>> m_workers;
+
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  std::unique_ptr<uring> m_ring;
+  vector_base<slot, std::allocator<slot>> m_slots;
+  vector_base<unsigned, std::allocator<unsigned>> m_free_slots;
+  vector_base<segment, std::allocator<segment>> m_waiting;
+  std::size_t m_next_waiting = 0;
+#endif
+};
+
+} // namespace constexpr_containers
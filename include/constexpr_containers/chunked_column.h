@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Closed interval [low, high] used as a scan predicate
+template<typename T>
+struct value_range
+{
+  T low;
+  T high;
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(const T& v) //
+    const noexcept
+  {
+    return low <= v and v <= high;
+  }
+};
+
+// Returns a mask with bit i set when values[i] lies in range, for i < 64.
+// NaNs never lie in a range.
+template<typename T>
+[[nodiscard]] constexpr //
+  std::uint64_t
+  range_mask_64(const T* values, value_range<T> range) //
+  noexcept
+{
+#if defined(__AVX2__)
+  if (not std::is_constant_evaluated()) {
+    std::uint64_t mask = 0;
+    if constexpr (std::is_same_v<T, float>) {
+      const auto low = _mm256_set1_ps(range.low);
+      const auto high = _mm256_set1_ps(range.high);
+      for (unsigned i = 0; i < 64; i += 8) {
+        const auto v = _mm256_loadu_ps(values + i);
+        const auto in = _mm256_and_ps(_mm256_cmp_ps(v, low, _CMP_GE_OQ),
+                                      _mm256_cmp_ps(v, high, _CMP_LE_OQ));
+        mask |= std::uint64_t(unsigned(_mm256_movemask_ps(in))) << i;
+      }
+      return mask;
+    } else if constexpr (std::is_same_v<T, double>) {
+      const auto low = _mm256_set1_pd(range.low);
+      const auto high = _mm256_set1_pd(range.high);
+      for (unsigned i = 0; i < 64; i += 4) {
+        const auto v = _mm256_loadu_pd(values + i);
+        const auto in = _mm256_and_pd(_mm256_cmp_pd(v, low, _CMP_GE_OQ),
+                                      _mm256_cmp_pd(v, high, _CMP_LE_OQ));
+        mask |= std::uint64_t(unsigned(_mm256_movemask_pd(in))) << i;
+      }
+      return mask;
+    } else if constexpr (std::is_integral_v<T> and std::is_signed_v<T> and sizeof(T) == 4) {
+      const auto low = _mm256_set1_epi32(range.low);
+      const auto high = _mm256_set1_epi32(range.high);
+      for (unsigned i = 0; i < 64; i += 8) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const auto out = _mm256_or_si256(_mm256_cmpgt_epi32(low, v), _mm256_cmpgt_epi32(v, high));
+        const auto in = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFF;
+        mask |= std::uint64_t(in) << i;
+      }
+      return mask;
+    } else if constexpr (std::is_integral_v<T> and std::is_signed_v<T> and sizeof(T) == 8) {
+      const auto low = _mm256_set1_epi64x(range.low);
+      const auto high = _mm256_set1_epi64x(range.high);
+      for (unsigned i = 0; i < 64; i += 4) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const auto out = _mm256_or_si256(_mm256_cmpgt_epi64(low, v), _mm256_cmpgt_epi64(v, high));
+        const auto in = ~unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(out))) & 0xF;
+        mask |= std::uint64_t(in) << i;
+      }
+      return mask;
+    }
+  }
+#endif
+  // Branchless so that the compiler can vectorize it for the remaining types
+  std::uint64_t mask = 0;
+  for (unsigned i = 0; i < 64; ++i) {
+    mask |= std::uint64_t(range.low <= values[i] and values[i] <= range.high) << i;
+  }
+  return mask;
+}
+
+// Append-only column of arithmetic values, split into fixed-size chunks that each carry a zone
+// map (min, max and null count). Values are stored contiguously, and a validity bitmap is only
+// allocated once the first null is appended.
+//
+// Synopsis:
+//
+// push_back(value), push_null(), append(first, last)
+//   Appends values, keeping the zone map of the last chunk up to date
+// zone(chunk)
+//   Returns the zone map of a chunk
+// scan(range, callback)
+//   Calls callback(index, value) for every non-null value in range, in index order.
+//   Chunks whose zone map does not overlap range are skipped without being read,
+//   the others are filtered 64 values at a time.
+template<typename T, std::size_t ChunkSize = 4096, typename Allocator = std::allocator<T>>
+  requires std::is_arithmetic_v<T>
+struct chunked_column
+{
+  static_assert(ChunkSize % 64 == 0, "Chunks must cover whole words of the validity bitmap.");
+
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr size_type chunk_size = ChunkSize;
+
+  struct zone_map
+  {
+    // An all-null chunk has min > max
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    size_type null_count = 0;
+
+    [[nodiscard]] constexpr //
+      bool
+      overlaps(value_range<T> range) //
+      const noexcept
+    {
+      return min <= range.high and range.low <= max;
+    }
+  };
+
+private:
+  using ZoneAllocator = typename AllocTraitsT::template rebind_alloc<zone_map>;
+  using WordAllocator = typename AllocTraitsT::template rebind_alloc<std::uint64_t>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  vector_base<T, Allocator> m_values;
+  vector_base<zone_map, ZoneAllocator> m_zones;
+  vector_base<std::uint64_t, WordAllocator> m_validity;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr chunked_column() = default;
+
+  constexpr explicit //
+    chunked_column(const Allocator& alloc)
+    : m_values(alloc)
+    , m_zones(ZoneAllocator(alloc))
+    , m_validity(WordAllocator(alloc))
+  {}
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    chunked_column(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+    : chunked_column(alloc)
+  {
+    append(first, last);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr const T* data() /*********/ const noexcept { return m_values.data(); }
+  [[nodiscard]] constexpr size_type size() /********/ const noexcept { return m_values.size(); }
+  [[nodiscard]] constexpr bool empty() /************/ const noexcept { return size() == 0; }
+  [[nodiscard]] constexpr size_type chunk_count() /**/ const noexcept { return m_zones.size(); }
+  [[nodiscard]] constexpr T operator[](size_type pos) const noexcept { return m_values[pos]; }
+
+  [[nodiscard]] constexpr //
+    const zone_map&
+    zone(size_type chunk) //
+    const noexcept
+  {
+    return m_zones[chunk];
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    is_null(size_type pos) //
+    const noexcept
+  {
+    return not m_validity.empty() and not(m_validity[pos / 64] >> (pos % 64) & 1);
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  constexpr //
+    void
+    push_back(T value)
+  {
+    auto& zone = next_slot();
+    zone.min = value < zone.min ? value : zone.min;
+    zone.max = zone.max < value ? value : zone.max;
+    m_values.push_back(value);
+  }
+
+  constexpr //
+    void
+    push_null()
+  {
+    if (m_validity.empty()) {
+      // Everything before the first null is valid
+      for (size_type i = 0; i < size() / 64 + 1; ++i) {
+        m_validity.push_back(~std::uint64_t{ 0 });
+      }
+    }
+    auto& zone = next_slot();
+    ++zone.null_count;
+    m_validity[size() / 64] &= ~(std::uint64_t{ 1 } << (size() % 64));
+    m_values.push_back(T{});
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    m_values.clear();
+    m_zones.clear();
+    m_validity.clear();
+  }
+
+  //////////////
+  // Scanning //
+  //////////////
+
+  template<typename Callback>
+  constexpr //
+    size_type
+    scan(value_range<T> range, Callback callback) //
+    const
+  {
+    size_type matches = 0;
+    for (size_type chunk = 0; chunk < m_zones.size(); ++chunk) {
+      const auto& zone = m_zones[chunk];
+      if (not zone.overlaps(range)) {
+        continue;
+      }
+
+      const auto first = chunk * chunk_size;
+      const auto last = std::min(first + chunk_size, size());
+      // Integral chunks inside the range match entirely (floating point ones may hold NaNs)
+      const bool all = std::is_integral_v<T> and zone.null_count == 0 and
+                       range.low <= zone.min and zone.max <= range.high;
+      for (auto word = first; word < last; word += 64) {
+        std::uint64_t mask = ~std::uint64_t{ 0 };
+        if (last - word < 64) {
+          mask >>= 64 - (last - word);
+        }
+        if (not all) {
+          mask &= last - word < 64 ? range_mask_partial(word, last, range) :
+                                     range_mask_64(m_values.data() + word, range);
+          if (not m_validity.empty()) {
+            mask &= m_validity[word / 64];
+          }
+        }
+        for (; mask != 0; mask &= mask - 1) {
+          const auto index = word + std::countr_zero(mask);
+          callback(index, m_values[index]);
+          ++matches;
+        }
+      }
+    }
+    return matches;
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    count(value_range<T> range) //
+    const
+  {
+    return scan(range, [](size_type, const T&) {});
+  }
+
+private:
+  constexpr //
+    zone_map&
+    next_slot()
+  {
+    if (size() % chunk_size == 0) {
+      m_zones.push_back(zone_map{});
+    }
+    if (not m_validity.empty() and size() % 64 == 0 and size() / 64 == m_validity.size()) {
+      m_validity.push_back(~std::uint64_t{ 0 });
+    }
+    return m_zones.back();
+  }
+
+  [[nodiscard]] constexpr //
+    std::uint64_t
+    range_mask_partial(size_type first, size_type last, value_range<T> range) //
+    const noexcept
+  {
+    std::uint64_t mask = 0;
+    for (auto i = first; i < last; ++i) {
+      mask |= std::uint64_t(range.contains(m_values[i])) << (i - first);
+    }
+    return mask;
+  }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+#include "constexpr_containers/views.h"
+
+namespace constexpr_containers {
+
+// Directed graph in compressed sparse row form: the targets of the edges leaving vertex v are
+// targets[offsets[v], offsets[v + 1]), in the order the edges were given.
+//
+// Synopsis:
+//
+// csr_graph<Vertex, Allocator>(edges, vertex_count, threads = 1)
+//   Builds the graph from (source, target) pairs, all below vertex_count, by a counting sort on
+//   the source: threads count their share of the edges, the counts are turned into offsets with
+//   a prefix sum split by vertex ranges, and every thread scatters its share into place
+// neighbors(v)
+//   The targets of the edges leaving v, as a contiguous span
+// bfs(graph, source, visit)
+//   Breadth-first search from source, calling visit(vertex, depth) for every vertex reached, in
+//   order of depth. Returns the number of vertices reached
+//
+// Construction and traversal are constexpr; construction runs on a single thread then.
+
+template<std::unsigned_integral Vertex = std::uint32_t,
+         typename Allocator = std::allocator<Vertex>>
+struct csr_graph
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using vertex_type = Vertex;
+  using edge_type = std::pair<Vertex, Vertex>;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  // Below this many edges per thread, extra threads cost more than they save
+  static constexpr size_type min_edges_per_thread = size_type{ 1 } << 16;
+
+private:
+  using SizeAllocator = typename AllocTraitsT::template rebind_alloc<size_type>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  vector_base<size_type, SizeAllocator> m_offsets;
+  vector_base<Vertex, Allocator> m_targets;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr csr_graph() = default;
+
+  constexpr //
+    csr_graph(std::span<const edge_type> edges,
+              size_type vertex_count,
+              unsigned threads = 1,
+              const Allocator& alloc = Allocator())
+    : m_offsets(SizeAllocator(alloc))
+    , m_targets(alloc)
+  {
+    const auto n = edges.size();
+    threads = static_cast<unsigned>(
+      std::clamp<size_type>(n / min_edges_per_thread, 1, std::max(threads, 1u)));
+    const auto edge_share = [&](unsigned t) {
+      return std::pair(n * t / threads, n * (t + 1) / threads);
+    };
+    const auto vertex_share = [&](unsigned t) {
+      return std::pair(vertex_count * t / threads, vertex_count * (t + 1) / threads);
+    };
+
+    // counts[t * vertex_count + v] is how many edges from v thread t has, then where the first
+    // of them goes
+    vector_base<size_type, SizeAllocator> counts(size_type{ threads } * vertex_count,
+                                                 SizeAllocator(alloc));
+    parallel_for(threads, [&](unsigned t) {
+      auto* const count = counts.data() + size_type{ t } * vertex_count;
+      for (auto [e, last] = edge_share(t); e < last; ++e) {
+        ++count[edges[e].first];
+      }
+    });
+
+    // Exclusive prefix sum in (vertex, thread) order, split by vertex ranges
+    vector_base<size_type, SizeAllocator> range_start(threads + 1, SizeAllocator(alloc));
+    parallel_for(threads, [&](unsigned t) {
+      size_type total = 0;
+      for (auto [v, last] = vertex_share(t); v < last; ++v) {
+        for (unsigned u = 0; u < threads; ++u) {
+          total += counts[u * vertex_count + v];
+        }
+      }
+      range_start[t + 1] = total;
+    });
+    for (unsigned t = 0; t < threads; ++t) {
+      range_start[t + 1] += range_start[t];
+    }
+    m_offsets.resize(vertex_count + 1);
+    parallel_for(threads, [&](unsigned t) {
+      auto running = range_start[t];
+      for (auto [v, last] = vertex_share(t); v < last; ++v) {
+        m_offsets[v] = running;
+        for (unsigned u = 0; u < threads; ++u) {
+          running += std::exchange(counts[u * vertex_count + v], running);
+        }
+      }
+    });
+    m_offsets[vertex_count] = n;
+
+    // Scattering thread by thread, in edge order, keeps the edges of a vertex in input order
+    // Every target is written exactly once, so they skip value-initialization
+    m_targets.append_uninitialized(n, [&](Vertex* targets, size_type) {
+      parallel_for(threads, [&](unsigned t) {
+        auto* const next = counts.data() + size_type{ t } * vertex_count;
+        for (auto [e, last] = edge_share(t); e < last; ++e) {
+          targets[next[edges[e].first]++] = edges[e].second;
+        }
+      });
+      return n;
+    });
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type edge_count() const noexcept { return m_targets.size(); }
+
+  [[nodiscard]] constexpr //
+    size_type
+    vertex_count() //
+    const noexcept
+  {
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    degree(Vertex v) //
+    const noexcept
+  {
+    return m_offsets[v + 1] - m_offsets[v];
+  }
+
+  [[nodiscard]] constexpr //
+    std::span<const Vertex>
+    neighbors(Vertex v) //
+    const noexcept
+  {
+    return as_span(m_targets).subspan(m_offsets[v], degree(v));
+  }
+
+  [[nodiscard]] constexpr //
+    std::span<const size_type>
+    offsets() //
+    const noexcept
+  {
+    return as_span(m_offsets);
+  }
+
+  [[nodiscard]] constexpr //
+    std::span<const Vertex>
+    targets() //
+    const noexcept
+  {
+    return as_span(m_targets);
+  }
+};
+
+/////////
+// bfs //
+/////////
+
+template<typename Vertex, typename Allocator, typename Visit>
+constexpr //
+  typename csr_graph<Vertex, Allocator>::size_type
+  bfs(const csr_graph<Vertex, Allocator>& graph, Vertex source, Visit visit)
+{
+  using size_type = typename csr_graph<Vertex, Allocator>::size_type;
+
+  vector_base<std::uint64_t, std::allocator<std::uint64_t>> visited(
+    (graph.vertex_count() + 63) / 64);
+  vector_base<Vertex, std::allocator<Vertex>> frontier;
+  vector_base<Vertex, std::allocator<Vertex>> next;
+
+  visited[source / 64] |= std::uint64_t{ 1 } << (source % 64);
+  frontier.push_back(source);
+  size_type reached = 0;
+  for (size_type depth = 0; not frontier.empty(); ++depth) {
+    for (const auto v : frontier) {
+      visit(v, depth);
+      for (const auto w : graph.neighbors(v)) {
+        const auto bit = std::uint64_t{ 1 } << (w % 64);
+        if (not(visited[w / 64] & bit)) {
+          visited[w / 64] |= bit;
+          next.push_back(w);
+        }
+      }
+    }
+    reached += frontier.size();
+    std::swap(frontier, next);
+    next.clear();
+  }
+  return reached;
+}
+
+} // namespace constexpr_containers
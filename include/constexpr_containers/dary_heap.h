@@ -0,0 +1,545 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Heaps where every node has D children instead of 2. The tree is D / 2 times shallower, so
+// pops touch fewer cache lines, and with small values the D children of a node share one.
+//
+// Synopsis:
+//
+// make_dary_heap<D>(first, last, comp), push_dary_heap<D>(...), pop_dary_heap<D>(...)
+//   Like std::make_heap, std::push_heap and std::pop_heap, with D children per node
+// dary_heap<T, D, Compare, Allocator>
+//   Priority queue like std::priority_queue (comp(a, b) means a comes out after b), stored in
+//   a vector_base. replace_top(value) swaps the top for value with a single sift, which is
+//   cheaper than pop() followed by push(value)
+// indexed_dary_heap<T, D, Compare, Allocator>
+//   Like dary_heap, but push returns a handle that stays valid until the element leaves the
+//   heap, through which the element can be read, updated (decrease-key) or erased.
+//   Handles of elements that left the heap are reused.
+
+/////////////////////
+// Heap primitives //
+/////////////////////
+
+// Moved(from, to) is told about every element that moves up or down a level, which is how
+// indexed_dary_heap keeps track of positions. Both return where the sifted element ended up.
+
+template<std::size_t D, std::random_access_iterator It, typename Compare, typename Moved>
+constexpr //
+  std::size_t
+  dary_sift_up(It first, std::size_t pos, Compare& comp, Moved moved)
+{
+  auto value = std::move(first[pos]);
+  while (pos > 0) {
+    const auto parent = (pos - 1) / D;
+    if (not comp(first[parent], value)) {
+      break;
+    }
+    first[pos] = std::move(first[parent]);
+    moved(parent, pos);
+    pos = parent;
+  }
+  first[pos] = std::move(value);
+  return pos;
+}
+
+// Index of the child that should be nearest the root among first[i, i + N), picked as a knockout
+// tournament whose rounds compile to arithmetic instead of branches, which would mispredict
+// about half the time
+template<std::size_t N, std::random_access_iterator It, typename Compare>
+[[nodiscard]] constexpr //
+  std::size_t
+  dary_best_of(It first, std::size_t i, Compare& comp)
+{
+  if constexpr (N == 1) {
+    return i;
+  } else {
+    const auto a = dary_best_of<N / 2>(first, i, comp);
+    const auto b = dary_best_of<N - N / 2>(first, i + N / 2, comp);
+    return a + (b - a) * std::size_t(comp(first[a], first[b]));
+  }
+}
+
+// Bottom-up, as in std::pop_heap: the hole at pos first sinks to a leaf along the best children,
+// then the value rises back from there. Values sifted down mostly belong near the leaves, so this
+// saves a comparison per level, and a hard to predict branch with it.
+template<std::size_t D, std::random_access_iterator It, typename Compare, typename Moved>
+constexpr //
+  std::size_t
+  dary_sift_down(It first, std::size_t n, std::size_t pos, Compare& comp, Moved moved)
+{
+  const auto top = pos;
+  auto value = std::move(first[pos]);
+  for (auto child = D * pos + 1; child < n; child = D * pos + 1) {
+    auto best = child;
+    if (child + D <= n) {
+      if (not std::is_constant_evaluated() and D * (child + D) < n) {
+        // Every grandchild is a candidate for the next level, and they are contiguous
+        const auto* grandchildren = std::addressof(first[D * child + 1]);
+        for (std::size_t i = 0; i < D * D * sizeof(*grandchildren); i += 64) {
+          __builtin_prefetch(reinterpret_cast<const char*>(grandchildren) + i);
+        }
+      }
+      best = dary_best_of<D>(first, child, comp);
+    } else {
+      for (auto i = child + 1; i < n; ++i) {
+        best = comp(first[best], first[i]) ? i : best;
+      }
+    }
+    first[pos] = std::move(first[best]);
+    moved(best, pos);
+    pos = best;
+  }
+  while (pos > top) {
+    const auto parent = (pos - 1) / D;
+    if (not comp(first[parent], value)) {
+      break;
+    }
+    first[pos] = std::move(first[parent]);
+    moved(parent, pos);
+    pos = parent;
+  }
+  first[pos] = std::move(value);
+  return pos;
+}
+
+struct no_heap_moves
+{
+  constexpr void operator()(std::size_t, std::size_t) const noexcept {}
+};
+
+// The number of nodes with children, which make_dary_heap sifts down from last to first
+template<std::size_t D>
+[[nodiscard]] constexpr //
+  std::size_t
+  dary_inner_nodes(std::size_t n) //
+  noexcept
+{
+  return n > 1 ? (n - 2) / D + 1 : 0;
+}
+
+template<std::size_t D, std::random_access_iterator It, typename Compare = std::less<>>
+constexpr //
+  void
+  make_dary_heap(It first, It last, Compare comp = {})
+{
+  // Floyd's construction, O(n)
+  const auto n = static_cast<std::size_t>(last - first);
+  for (auto i = dary_inner_nodes<D>(n); i > 0; --i) {
+    dary_sift_down<D>(first, n, i - 1, comp, no_heap_moves{});
+  }
+}
+
+template<std::size_t D, std::random_access_iterator It, typename Compare = std::less<>>
+constexpr //
+  void
+  push_dary_heap(It first, It last, Compare comp = {})
+{
+  dary_sift_up<D>(first, static_cast<std::size_t>(last - first) - 1, comp, no_heap_moves{});
+}
+
+template<std::size_t D, std::random_access_iterator It, typename Compare = std::less<>>
+constexpr //
+  void
+  pop_dary_heap(It first, It last, Compare comp = {})
+{
+  const auto n = static_cast<std::size_t>(last - first) - 1;
+  if (n > 0) {
+    std::iter_swap(first, first + n);
+    dary_sift_down<D>(first, n, 0, comp, no_heap_moves{});
+  }
+}
+
+///////////////
+// dary_heap //
+///////////////
+
+template<typename T,
+         std::size_t D = 4,
+         typename Compare = std::less<T>,
+         typename Allocator = std::allocator<T>>
+struct dary_heap
+{
+  static_assert(D >= 2, "A heap node needs at least two children.");
+
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using value_type = T;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+  using const_reference = const T&;
+
+  static constexpr size_type arity = D;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  vector_base<T, Allocator> m_values;
+  [[no_unique_address]] Compare m_comp;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr dary_heap() = default;
+
+  constexpr explicit //
+    dary_heap(const Compare& comp, const Allocator& alloc = Allocator())
+    : m_values(alloc)
+    , m_comp(comp)
+  {}
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    dary_heap(InputIt first,
+              InputIt last,
+              const Compare& comp = Compare(),
+              const Allocator& alloc = Allocator())
+    : m_values(first, last, alloc)
+    , m_comp(comp)
+  {
+    make_dary_heap<D>(m_values.begin(), m_values.end(), m_comp);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr const_reference top() /**/ const noexcept { return m_values[0]; }
+  [[nodiscard]] constexpr size_type size() /********/ const noexcept { return m_values.size(); }
+  [[nodiscard]] constexpr bool empty() /************/ const noexcept { return m_values.empty(); }
+  [[nodiscard]] constexpr const T* data() /*********/ const noexcept { return m_values.data(); }
+  [[nodiscard]] constexpr Compare value_comp() /****/ const noexcept { return m_comp; }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  constexpr void reserve(size_type n) { m_values.reserve(n); }
+  constexpr void clear() noexcept { m_values.clear(); }
+
+  template<typename... Args>
+  constexpr //
+    void
+    emplace(Args&&... args)
+  {
+    m_values.emplace_back(std::forward<Args>(args)...);
+    dary_sift_up<D>(m_values.begin(), size() - 1, m_comp, no_heap_moves{});
+  }
+
+  constexpr void push(const T& value) { emplace(value); }
+  constexpr void push(T&& value) { emplace(std::move(value)); }
+
+  // Pushes a range, rebuilding the whole heap at once when that is cheaper
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    const auto old_size = size();
+    for (; first != last; ++first) {
+      m_values.push_back(*first);
+    }
+    if (size() - old_size > old_size) {
+      make_dary_heap<D>(m_values.begin(), m_values.end(), m_comp);
+    } else {
+      for (auto i = old_size; i < size(); ++i) {
+        dary_sift_up<D>(m_values.begin(), i, m_comp, no_heap_moves{});
+      }
+    }
+  }
+
+  constexpr //
+    void
+    pop()
+  {
+    if (size() > 1) {
+      m_values[0] = std::move(m_values.back());
+      m_values.pop_back();
+      dary_sift_down<D>(m_values.begin(), size(), 0, m_comp, no_heap_moves{});
+    } else {
+      m_values.pop_back();
+    }
+  }
+
+  // Equivalent to pop() then push(value)
+  constexpr //
+    void
+    replace_top(T value)
+  {
+    m_values[0] = std::move(value);
+    dary_sift_down<D>(m_values.begin(), size(), 0, m_comp, no_heap_moves{});
+  }
+};
+
+///////////////////////
+// indexed_dary_heap //
+///////////////////////
+
+template<typename T,
+         std::size_t D = 4,
+         typename Compare = std::less<T>,
+         typename Allocator = std::allocator<T>>
+struct indexed_dary_heap
+{
+  static_assert(D >= 2, "A heap node needs at least two children.");
+
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using value_type = T;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+  using const_reference = const T&;
+  using handle_type = size_type;
+
+  static constexpr size_type arity = D;
+
+private:
+  using SizeAllocator = typename AllocTraitsT::template rebind_alloc<size_type>;
+
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  vector_base<T, Allocator> m_values;
+  // Handle of the element at each heap position
+  vector_base<handle_type, SizeAllocator> m_handles;
+  // Heap position of each handle, npos once it has left the heap
+  vector_base<size_type, SizeAllocator> m_positions;
+  vector_base<handle_type, SizeAllocator> m_free;
+  [[no_unique_address]] Compare m_comp;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr indexed_dary_heap() = default;
+
+  constexpr explicit //
+    indexed_dary_heap(const Compare& comp, const Allocator& alloc = Allocator())
+    : m_values(alloc)
+    , m_handles(SizeAllocator(alloc))
+    , m_positions(SizeAllocator(alloc))
+    , m_free(SizeAllocator(alloc))
+    , m_comp(comp)
+  {}
+
+  // Element i of the range gets handle i
+  template<std::input_iterator InputIt>
+  constexpr //
+    indexed_dary_heap(InputIt first,
+                      InputIt last,
+                      const Compare& comp = Compare(),
+                      const Allocator& alloc = Allocator())
+    : indexed_dary_heap(comp, alloc)
+  {
+    for (; first != last; ++first) {
+      m_handles.push_back(m_values.size());
+      m_positions.push_back(m_values.size());
+      m_values.push_back(*first);
+    }
+    for (auto i = dary_inner_nodes<D>(size()); i > 0; --i) {
+      sift_down(i - 1);
+    }
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr const_reference top() /*****/ const noexcept { return m_values[0]; }
+  [[nodiscard]] constexpr handle_type top_handle() /**/ const noexcept { return m_handles[0]; }
+  [[nodiscard]] constexpr size_type size() /**********/ const noexcept { return m_values.size(); }
+  [[nodiscard]] constexpr bool empty() /**************/ const noexcept { return m_values.empty(); }
+  [[nodiscard]] constexpr Compare value_comp() /******/ const noexcept { return m_comp; }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(handle_type handle) //
+    const noexcept
+  {
+    return handle < m_positions.size() and m_positions[handle] != npos;
+  }
+
+  [[nodiscard]] constexpr //
+    const_reference
+    operator[](handle_type handle) //
+    const noexcept
+  {
+    return m_values[m_positions[handle]];
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  constexpr //
+    void
+    reserve(size_type n)
+  {
+    m_values.reserve(n);
+    m_handles.reserve(n);
+    m_positions.reserve(n);
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    m_values.clear();
+    m_handles.clear();
+    m_positions.clear();
+    m_free.clear();
+  }
+
+  template<typename... Args>
+  constexpr //
+    handle_type
+    emplace(Args&&... args)
+  {
+    m_values.emplace_back(std::forward<Args>(args)...);
+    const bool reuse = not m_free.empty();
+    const handle_type handle = reuse ? m_free.back() : m_positions.size();
+    try {
+      if (not reuse) {
+        m_positions.push_back(npos);
+      }
+      m_handles.push_back(handle);
+    } catch (...) {
+      m_values.pop_back();
+      throw;
+    }
+    if (reuse) {
+      m_free.pop_back();
+    }
+    sift_up(size() - 1);
+    return handle;
+  }
+
+  constexpr handle_type push(const T& value) { return emplace(value); }
+  constexpr handle_type push(T&& value) { return emplace(std::move(value)); }
+
+  constexpr //
+    void
+    pop()
+  {
+    erase(top_handle());
+  }
+
+  constexpr //
+    void
+    replace_top(T value)
+  {
+    update(top_handle(), std::move(value));
+  }
+
+  // Changes the value behind handle, moving it up or down as needed
+  constexpr //
+    void
+    update(handle_type handle, T value)
+  {
+    const auto pos = m_positions[handle];
+    const bool up = m_comp(m_values[pos], value);
+    m_values[pos] = std::move(value);
+    if (up) {
+      sift_up(pos);
+    } else {
+      sift_down(pos);
+    }
+  }
+
+  constexpr //
+    void
+    erase(handle_type handle)
+  {
+    const auto pos = m_positions[handle];
+    const auto last = size() - 1;
+    m_free.push_back(handle);
+    m_positions[handle] = npos;
+    if (pos != last) {
+      const bool up = m_comp(m_values[pos], m_values[last]);
+      m_values[pos] = std::move(m_values[last]);
+      m_handles[pos] = m_handles[last];
+      m_values.pop_back();
+      m_handles.pop_back();
+      if (up) {
+        sift_up(pos);
+      } else {
+        sift_down(pos);
+      }
+    } else {
+      m_values.pop_back();
+      m_handles.pop_back();
+    }
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    auto
+    mover() //
+    noexcept
+  {
+    return [this](size_type from, size_type to) {
+      m_handles[to] = m_handles[from];
+      m_positions[m_handles[to]] = to;
+    };
+  }
+
+  // Sifts the element at pos and records where it and everything it displaced ended up
+  constexpr //
+    void
+    sift_up(size_type pos)
+  {
+    const auto handle = m_handles[pos];
+    pos = dary_sift_up<D>(m_values.begin(), pos, m_comp, mover());
+    m_handles[pos] = handle;
+    m_positions[handle] = pos;
+  }
+
+  constexpr //
+    void
+    sift_down(size_type pos)
+  {
+    const auto handle = m_handles[pos];
+    pos = dary_sift_down<D>(m_values.begin(), size(), pos, m_comp, mover());
+    m_handles[pos] = handle;
+    m_positions[handle] = pos;
+  }
+};
+
+} // namespace constexpr_containers
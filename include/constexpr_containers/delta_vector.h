@@ -0,0 +1,404 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "constexpr_containers/exceptions.h"
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Append-only container of unsigned integers, compressed with block-based delta encoding and
+// bit-packing.
+//
+// Elements are grouped into blocks of block_size. Each block stores the differences between
+// consecutive elements, bit-packed at the width of the widest difference in that block, and a
+// skip table records the first element and packed offset of every block, so lookups only ever
+// decode a single block. Elements that do not yet fill a block stay uncompressed in a tail.
+//
+// Differences are taken modulo 2^digits so that any sequence round-trips, but only sorted (or
+// mostly sorted) sequences compress well, and lower_bound / contains require sorted contents.
+//
+// Packed words are interleaved across four lanes: element i of a block belongs to lane i % 4, and
+// word 4 * k + lane holds bits [64 * k, 64 * k + 64) of that lane's bitstream. Every lane then
+// needs the same shifts, which lets a block decode four elements per step with 256-bit vectors
+// while staying readable by the scalar (and constexpr) path.
+//
+// Synopsis:
+//
+// push_back(value), append(first, last)
+//   Appends elements, compressing the tail whenever it fills a block
+// operator[](pos), at(pos)
+//   Returns the element at pos by value, decoding at most one block
+// decode(out)
+//   Appends every element to the vector_base out
+// decode_block(block, dst)
+//   Writes the block_size elements of a compressed block to dst
+// lower_bound(value), contains(value)
+//   Binary searches the skip table, then decodes a single block
+// memory_usage()
+//   Bytes of heap storage currently held
+template<std::unsigned_integral T, typename Allocator = std::allocator<T>>
+struct delta_vector
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  struct block_header
+  {
+    T first;
+    typename AllocTraitsT::size_type offset;
+    unsigned bits;
+  };
+
+  using WordAllocator = typename AllocTraitsT::template rebind_alloc<std::uint64_t>;
+  using HeaderAllocator = typename AllocTraitsT::template rebind_alloc<block_header>;
+
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr size_type block_size = 256;
+  static constexpr size_type lanes = 4;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+private:
+  vector_base<std::uint64_t, WordAllocator> m_words;
+  vector_base<block_header, HeaderAllocator> m_blocks;
+  vector_base<T, Allocator> m_tail;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr delta_vector() = default;
+
+  constexpr explicit //
+    delta_vector(const Allocator& alloc)
+    : m_words(WordAllocator(alloc))
+    , m_blocks(HeaderAllocator(alloc))
+    , m_tail(alloc)
+  {}
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    delta_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+    : delta_vector(alloc)
+  {
+    append(first, last);
+  }
+
+  constexpr delta_vector(std::initializer_list<T> il, const Allocator& alloc = Allocator())
+    : delta_vector(il.begin(), il.end(), alloc)
+  {}
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr //
+    Allocator
+    get_allocator() //
+    const noexcept
+  {
+    return m_tail.get_allocator();
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    size() //
+    const noexcept
+  {
+    return m_blocks.size() * block_size + m_tail.size();
+  }
+  [[nodiscard]] constexpr bool empty() /*******/ const noexcept { return size() == 0; }
+  [[nodiscard]] constexpr size_type block_count() const noexcept { return m_blocks.size(); }
+
+  [[nodiscard]] constexpr //
+    size_type
+    memory_usage() //
+    const noexcept
+  {
+    return m_words.capacity() * sizeof(std::uint64_t) +
+           m_blocks.capacity() * sizeof(block_header) + m_tail.capacity() * sizeof(T);
+  }
+
+  [[nodiscard]] constexpr //
+    value_type
+    operator[](size_type pos) //
+    const noexcept
+  {
+    const auto block = pos / block_size;
+    if (block >= m_blocks.size()) {
+      return m_tail[pos - m_blocks.size() * block_size];
+    }
+    const auto& header = m_blocks[block];
+    std::uint64_t acc = header.first;
+    if (header.bits != 0) {
+      const auto* words = m_words.data() + header.offset;
+      for (size_type i = 1; i <= pos % block_size; ++i) {
+        acc += unpack(words, header.bits, i);
+      }
+    }
+    return static_cast<T>(acc);
+  }
+
+  [[nodiscard]] constexpr //
+    value_type
+    at(size_type pos) //
+    const
+  {
+    if (pos >= size()) {
+      throw_out_of_range("Bounds check failed.");
+    }
+    return (*this)[pos];
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  constexpr //
+    void
+    push_back(T value)
+  {
+    if (m_tail.capacity() < block_size) {
+      m_tail.reserve(block_size);
+    }
+    m_tail.push_back(value);
+    if (m_tail.size() == block_size) {
+      encode_block(m_tail.data());
+      m_tail.clear();
+    }
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    m_words.clear();
+    m_blocks.clear();
+    m_tail.clear();
+  }
+
+  constexpr //
+    void
+    shrink_to_fit()
+  {
+    m_words.shrink_to_fit();
+    m_blocks.shrink_to_fit();
+  }
+
+  //////////////
+  // Decoding //
+  //////////////
+
+  constexpr //
+    void
+    decode_block(size_type block, T* dst) //
+    const noexcept
+  {
+    const auto& header = m_blocks[block];
+    const auto* words = m_words.data() + header.offset;
+#if defined(__AVX2__)
+    if constexpr (sizeof(T) == 4 or sizeof(T) == 8) {
+      if (not std::is_constant_evaluated()) {
+        decode_block_avx2(header, words, dst);
+        return;
+      }
+    }
+#endif
+    if (header.bits == 0) {
+      std::fill(dst, dst + block_size, header.first);
+      return;
+    }
+    std::uint64_t acc = header.first;
+    dst[0] = header.first;
+    for (size_type i = 1; i < block_size; ++i) {
+      acc += unpack(words, header.bits, i);
+      dst[i] = static_cast<T>(acc);
+    }
+  }
+
+  template<typename OutAllocator>
+  constexpr //
+    void
+    decode(vector_base<T, OutAllocator>& out) //
+    const
+  {
+    out.append_uninitialized(size(), [&](T* dst, size_type count) {
+      for (size_type block = 0; block < m_blocks.size(); ++block) {
+        decode_block(block, dst + block * block_size);
+      }
+      std::copy(m_tail.begin(), m_tail.end(), dst + m_blocks.size() * block_size);
+      return count;
+    });
+  }
+
+  ///////////////
+  // Searching //
+  ///////////////
+
+  // Requires the contents to be sorted.
+  [[nodiscard]] constexpr //
+    size_type
+    lower_bound(T value) //
+    const
+  {
+    const auto by_first = [](const block_header& header, const T& v) { return header.first < v; };
+    const size_type next =
+      std::lower_bound(m_blocks.begin(), m_blocks.end(), value, by_first) - m_blocks.begin();
+    if (next != 0) {
+      // The first element >= value is either in the preceding block or starts the next one
+      T decoded[block_size];
+      decode_block(next - 1, decoded);
+      const size_type pos = std::lower_bound(decoded, decoded + block_size, value) - decoded;
+      if (pos != block_size or next != m_blocks.size()) {
+        return (next - 1) * block_size + pos;
+      }
+    } else if (not m_blocks.empty()) {
+      return 0;
+    }
+    return m_blocks.size() * block_size +
+           (std::lower_bound(m_tail.begin(), m_tail.end(), value) - m_tail.begin());
+  }
+
+  // Requires the contents to be sorted.
+  [[nodiscard]] constexpr //
+    bool
+    contains(T value) //
+    const
+  {
+    const auto pos = lower_bound(value);
+    return pos != size() and (*this)[pos] == value;
+  }
+
+  ///////////////////////////
+  // Bit-packing utilities //
+  ///////////////////////////
+
+private:
+  // Reads the i-th delta of a block packed at the given width
+  [[nodiscard]] static constexpr //
+    std::uint64_t
+    unpack(const std::uint64_t* words, unsigned bits, size_type i) //
+    noexcept
+  {
+    const auto lane = i % lanes;
+    const auto offset = (i / lanes) * bits;
+    const auto word = offset / 64;
+    const auto shift = static_cast<unsigned>(offset % 64);
+    auto delta = words[lanes * word + lane] >> shift;
+    if (shift + bits > 64) {
+      delta |= words[lanes * (word + 1) + lane] << (64 - shift);
+    }
+    return bits == 64 ? delta : delta & ((std::uint64_t{ 1 } << bits) - 1);
+  }
+
+  constexpr //
+    void
+    encode_block(const T* values)
+  {
+    std::uint64_t deltas[block_size];
+    std::uint64_t widest = 0;
+    for (size_type i = 0; i < block_size; ++i) {
+      deltas[i] = static_cast<T>(values[i] - values[i == 0 ? 0 : i - 1]);
+      widest |= deltas[i];
+    }
+    const auto bits = static_cast<unsigned>(std::bit_width(widest));
+    const auto offset = m_words.size();
+    m_blocks.push_back(block_header{ values[0], offset, bits });
+    for (size_type i = 0; i < lanes * bits; ++i) {
+      m_words.push_back(0);
+    }
+
+    auto* words = m_words.data() + offset;
+    for (size_type i = 1; bits != 0 and i < block_size; ++i) {
+      const auto lane = i % lanes;
+      const auto bit = (i / lanes) * bits;
+      const auto word = bit / 64;
+      const auto shift = static_cast<unsigned>(bit % 64);
+      words[lanes * word + lane] |= deltas[i] << shift;
+      if (shift + bits > 64) {
+        words[lanes * (word + 1) + lane] |= deltas[i] >> (64 - shift);
+      }
+    }
+  }
+
+#if defined(__AVX2__)
+  static //
+    void
+    decode_block_avx2(const block_header& header, const std::uint64_t* words, T* dst) //
+    noexcept
+  {
+    const unsigned bits = header.bits;
+    const auto zero = _mm256_setzero_si256();
+    const auto mask = _mm256_set1_epi64x(
+      static_cast<long long>(bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bits) - 1));
+    auto total = _mm256_set1_epi64x(static_cast<long long>(header.first));
+    for (size_type step = 0; step < block_size / lanes; ++step) {
+      auto deltas = zero;
+      if (bits != 0) {
+        const auto offset = step * bits;
+        const auto* lo = words + lanes * (offset / 64);
+        const auto shift = static_cast<int>(offset % 64);
+        deltas = _mm256_srl_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo)),
+                                  _mm_cvtsi32_si128(shift));
+        if (shift + bits > 64) {
+          const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo + lanes));
+          deltas = _mm256_or_si256(deltas, _mm256_sll_epi64(hi, _mm_cvtsi32_si128(64 - shift)));
+        }
+        deltas = _mm256_and_si256(deltas, mask);
+      }
+
+      // Inclusive prefix sum across the four lanes, then carry in the running total
+      deltas = _mm256_add_epi64(
+        deltas, _mm256_blend_epi32(_mm256_permute4x64_epi64(deltas, 0x90), zero, 0x03));
+      deltas = _mm256_add_epi64(
+        deltas, _mm256_blend_epi32(_mm256_permute4x64_epi64(deltas, 0x40), zero, 0x0F));
+      total = _mm256_add_epi64(total, deltas);
+
+      if constexpr (sizeof(T) == 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + lanes * step), total);
+      } else {
+        const auto narrowed =
+          _mm256_permutevar8x32_epi32(total, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + lanes * step),
+                         _mm256_castsi256_si128(narrowed));
+      }
+      total = _mm256_permute4x64_epi64(total, 0xFF);
+    }
+  }
+#endif
+};
+
+} // namespace constexpr_containers
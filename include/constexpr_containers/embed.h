@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Bytes of data files available in constant evaluation, so that tables can be parsed from them at
+// compile time instead of at startup.
+//
+// The bytes come from a braced initializer, filled by #embed where the compiler supports it and
+// otherwise by a generated file of comma-separated byte values, which the Makefile builds as
+// $(OUT)/<path>.embed from each <path> listed in EMBEDS. #embed looks next to the source file,
+// while the generated file is included by its path from the repository root, here from
+// test/parse.cc with test/data/table.csv in EMBEDS:
+//
+//   constexpr unsigned char table_data[] = {
+//   #if CONSTEXPR_CONTAINERS_HAS_EMBED
+//   #embed "data/table.csv"
+//   #else
+//   #include "test/data/table.csv.embed"
+//   #endif
+//   };
+//
+// Synopsis:
+//
+// CONSTEXPR_CONTAINERS_HAS_EMBED
+//   1 when #embed is available, 0 otherwise
+// embedded_bytes(data)
+//   A vector_base<std::byte> holding a copy of data, to parse with the rest of the library
+// load_le<T>(bytes, offset)
+//   The little-endian unsigned integer T at offset, for binary formats
+// freeze<make>()
+//   Evaluates make(), a constexpr function returning a vector_base, at compile time and returns
+//   its elements as a std::array, which unlike the vector can outlive constant evaluation
+
+#if defined(__has_embed)
+#define CONSTEXPR_CONTAINERS_HAS_EMBED 1
+#else
+#define CONSTEXPR_CONTAINERS_HAS_EMBED 0
+#endif
+
+template<typename Allocator = std::allocator<std::byte>>
+[[nodiscard]] constexpr //
+  vector_base<std::byte, Allocator>
+  embedded_bytes(std::span<const unsigned char> data, const Allocator& alloc = Allocator())
+{
+  vector_base<std::byte, Allocator> bytes(data.size(), alloc);
+  std::transform(data.begin(), data.end(), bytes.begin(), [](unsigned char c) {
+    return static_cast<std::byte>(c);
+  });
+  return bytes;
+}
+
+template<std::unsigned_integral T>
+[[nodiscard]] constexpr //
+  T
+  load_le(std::span<const std::byte> bytes, std::size_t offset) //
+  noexcept
+{
+  T value = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<T>(bytes[offset + i]) << (8 * i));
+  }
+  return value;
+}
+
+template<auto Make>
+[[nodiscard]] consteval //
+  auto
+  freeze()
+{
+  using T = typename std::remove_cvref_t<decltype(Make())>::value_type;
+  // Once for the size, which must be a constant, once for the elements
+  std::array<T, Make().size()> table{};
+  const auto elements = Make();
+  std::copy(elements.begin(), elements.end(), table.begin());
+  return table;
+}
+
+} // namespace constexpr_containers
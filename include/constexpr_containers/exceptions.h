@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdexcept>
+
+namespace constexpr_containers {
+
+// The exceptions thrown by the containers, raised through these functions so that only this
+// header needs <stdexcept>, and the throw expressions stay out of the inlined fast paths.
+//
+// Synopsis:
+//
+// throw_out_of_range(what), throw_length_error(what), throw_logic_error(what),
+// throw_invalid_argument(what)
+//   Throws std::out_of_range / std::length_error / std::logic_error / std::invalid_argument with
+//   the message what
+
+[[noreturn]] inline void
+throw_out_of_range(const char* what)
+{
+  throw std::out_of_range(what);
+}
+
+[[noreturn]] inline void
+throw_length_error(const char* what)
+{
+  throw std::length_error(what);
+}
+
+[[noreturn]] inline void
+throw_logic_error(const char* what)
+{
+  throw std::logic_error(what);
+}
+
+[[noreturn]] inline void
+throw_invalid_argument(const char* what)
+{
+  throw std::invalid_argument(what);
+}
+
+} // namespace constexpr_containers
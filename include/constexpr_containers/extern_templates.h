@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Explicit instantiation declarations of the common vector_base member functions, for the element
+// types most code uses, so that translation units including this header stop instantiating and
+// emitting their own copies. The definitions are in src/extern_templates.cc, built into
+// libconstexpr_containers.a, which such translation units must then link.
+//
+// Synopsis:
+//
+// CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(prefix, T)
+//   One `prefix` declaration per member function of vector_base<T> covered: constructors,
+//   destructor, assignments, reserve, resize, push_back, pop_back and erase. Expand it with
+//   `template` in one translation unit and `extern template` in the others to share other
+//   element types the same way
+//
+// Member functions stay constexpr and inline: they are still instantiated wherever they are
+// evaluated at compile time or inlined, so this mostly saves time in unoptimized builds.
+
+#define CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(prefix, T)                                       \
+  prefix vector_base<T, std::allocator<T>>::vector_base(                                          \
+    std::size_t, const T&, const std::allocator<T>&);                                             \
+  prefix vector_base<T, std::allocator<T>>::vector_base(std::size_t, const std::allocator<T>&);   \
+  prefix vector_base<T, std::allocator<T>>::vector_base(const vector_base&);                      \
+  prefix vector_base<T, std::allocator<T>>::vector_base(                                          \
+    std::initializer_list<T>, const std::allocator<T>&);                                          \
+  prefix vector_base<T, std::allocator<T>>::~vector_base();                                       \
+  prefix vector_base<T, std::allocator<T>>& vector_base<T, std::allocator<T>>::operator=(         \
+    const vector_base&);                                                                          \
+  prefix vector_base<T, std::allocator<T>>& vector_base<T, std::allocator<T>>::operator=(         \
+    vector_base&&) noexcept;                                                                      \
+  prefix void vector_base<T, std::allocator<T>>::reserve(std::size_t);                            \
+  prefix void vector_base<T, std::allocator<T>>::shrink_to_fit();                                 \
+  prefix void vector_base<T, std::allocator<T>>::resize(std::size_t);                             \
+  prefix void vector_base<T, std::allocator<T>>::resize(std::size_t, const T&);                   \
+  prefix void vector_base<T, std::allocator<T>>::push_back(const T&);                             \
+  prefix void vector_base<T, std::allocator<T>>::push_back(T&&);                                  \
+  prefix void vector_base<T, std::allocator<T>>::pop_back();                                      \
+  prefix T* vector_base<T, std::allocator<T>>::erase(const T*, const T*);
+
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(extern template, int)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(extern template, std::uint32_t)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(extern template, std::uint64_t)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(extern template, double)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(extern template, std::byte)
+
+} // namespace constexpr_containers
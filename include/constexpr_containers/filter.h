@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Approximate membership filters over 64-bit keys, answering "definitely absent" or "maybe
+// present" in one or three cache misses, to skip expensive lookups of absent keys. Keys of other
+// types should be hashed to 64 bits first; the filters remix them, so a poor hash is fine.
+//
+// Synopsis:
+//
+// bloom_filter<Allocator>(keys, bits_per_key = 10)
+//   Blocked Bloom filter: a key sets one bit in each of the 8 words of one 64-byte block, so a
+//   query touches a single cache line. About 1% false positives at 10 bits per key; keys can be
+//   inserted after construction
+// xor_filter<Fingerprint, Allocator>(keys)
+//   Static filter storing one Fingerprint per 1.23 keys: a key is present when the xor of three
+//   fingerprints matches its own. False positives are 2^-bits of Fingerprint, 0.4% for 8 bits
+//
+// contains(key)
+//   False only when key was never added
+// contains_each(keys, out)
+//   Batch query: out[i] = contains(keys[i]), prefetching ahead. Returns the number of positives
+// data(), from_words(words)
+//   The filter as 64-bit words, and the filter rebuilt from them, for serialization
+//
+// Construction is constexpr, so filters of compile-time key sets can be built at compile time.
+
+// How many keys ahead contains_each prefetches
+inline constexpr std::size_t filter_prefetch_distance = 16;
+
+// Final mix of MurmurHash3, a bijection that spreads every input bit over the whole word
+[[nodiscard]] constexpr //
+  std::uint64_t
+  filter_hash(std::uint64_t key) //
+  noexcept
+{
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+// Maps a 32-bit hash uniformly onto [0, n) without a division
+[[nodiscard]] constexpr //
+  std::uint64_t
+  filter_reduce(std::uint32_t hash, std::uint64_t n) //
+  noexcept
+{
+  return (std::uint64_t{ hash } * n) >> 32;
+}
+
+//////////////////
+// bloom_filter //
+//////////////////
+
+template<typename Allocator = std::allocator<std::uint64_t>>
+struct bloom_filter
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using key_type = std::uint64_t;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr size_type block_words = 8;
+  static constexpr size_type block_bits = block_words * 64;
+
+private:
+  // Odd multipliers, one per word of a block, that pick the bit to set from the low hash half
+  static constexpr std::uint32_t salts[block_words] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                                        0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                                        0x9efc4947U, 0x5c6bfb31U };
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  vector_base<std::uint64_t, Allocator> m_words;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr bloom_filter() = default;
+
+  // Empty filter sized for expected_keys
+  constexpr explicit //
+    bloom_filter(size_type expected_keys,
+                 size_type bits_per_key = 10,
+                 const Allocator& alloc = Allocator())
+    : m_words(block_words * std::max<size_type>(
+                              1, (expected_keys * bits_per_key + block_bits - 1) / block_bits),
+              alloc)
+  {}
+
+  constexpr explicit //
+    bloom_filter(std::span<const key_type> keys,
+                 size_type bits_per_key = 10,
+                 const Allocator& alloc = Allocator())
+    : bloom_filter(keys.size(), bits_per_key, alloc)
+  {
+    for (const auto key : keys) {
+      insert(key);
+    }
+  }
+
+  // Rebuilds a filter from the words of data(); their count must be a multiple of block_words
+  [[nodiscard]] static constexpr //
+    bloom_filter
+    from_words(std::span<const std::uint64_t> words, const Allocator& alloc = Allocator())
+  {
+    bloom_filter filter;
+    filter.m_words = vector_base<std::uint64_t, Allocator>(words.begin(), words.end(), alloc);
+    return filter;
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type block_count() /**/ const noexcept
+  {
+    return m_words.size() / block_words;
+  }
+
+  [[nodiscard]] constexpr //
+    std::span<const std::uint64_t>
+    data() //
+    const noexcept
+  {
+    return as_span(m_words);
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(key_type key) //
+    const noexcept
+  {
+    if (m_words.empty()) {
+      return false;
+    }
+    const auto hash = filter_hash(key);
+    const auto* block = m_words.data() + block_offset(hash);
+#if defined(__AVX2__)
+    if (not std::is_constant_evaluated()) {
+      const auto low = static_cast<std::uint32_t>(hash);
+      const auto* words = reinterpret_cast<const __m256i*>(block);
+      return _mm256_testc_si256(_mm256_loadu_si256(words), mask(low, 0)) &
+             _mm256_testc_si256(_mm256_loadu_si256(words + 1), mask(low, 4));
+    }
+#endif
+    bool found = true;
+    for (size_type i = 0; i < block_words; ++i) {
+      found &= (block[i] >> bit_of(static_cast<std::uint32_t>(hash), i)) & 1;
+    }
+    return found;
+  }
+
+  constexpr //
+    size_type
+    contains_each(std::span<const key_type> keys, std::span<bool> out) //
+    const noexcept
+  {
+    size_type positives = 0;
+    for (size_type i = 0; i < keys.size(); ++i) {
+      if (not std::is_constant_evaluated() and not m_words.empty() and
+          i + filter_prefetch_distance < keys.size()) {
+        const auto next = filter_hash(keys[i + filter_prefetch_distance]);
+        __builtin_prefetch(m_words.data() + block_offset(next));
+      }
+      out[i] = contains(keys[i]);
+      positives += out[i];
+    }
+    return positives;
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  // A default-constructed filter gets a single block
+  constexpr //
+    void
+    insert(key_type key)
+  {
+    if (m_words.empty()) {
+      m_words.resize(block_words);
+    }
+    const auto hash = filter_hash(key);
+    auto* block = m_words.data() + block_offset(hash);
+    for (size_type i = 0; i < block_words; ++i) {
+      block[i] |= std::uint64_t{ 1 } << bit_of(static_cast<std::uint32_t>(hash), i);
+    }
+  }
+
+private:
+  // The high half of the hash picks the block, the low half the bits within it
+  [[nodiscard]] constexpr //
+    size_type
+    block_offset(std::uint64_t hash) //
+    const noexcept
+  {
+    return block_words * filter_reduce(static_cast<std::uint32_t>(hash >> 32), block_count());
+  }
+
+  [[nodiscard]] static constexpr //
+    unsigned
+    bit_of(std::uint32_t hash, size_type word) //
+    noexcept
+  {
+    return static_cast<std::uint32_t>(hash * salts[word]) >> 26;
+  }
+
+#if defined(__AVX2__)
+  // The bits to test in words [first, first + 4) of a block, by the multiply and shift of bit_of
+  [[nodiscard]] static //
+    __m256i
+    mask(std::uint32_t hash, size_type first) //
+    noexcept
+  {
+    const auto salt = _mm256_setr_epi64x(salts[first], salts[first + 1], salts[first + 2],
+                                         salts[first + 3]);
+    // Low 32 bits of the product, then their top 6
+    const auto product = _mm256_mul_epu32(_mm256_set1_epi64x(hash), salt);
+    const auto bit = _mm256_srli_epi64(_mm256_slli_epi64(product, 32), 58);
+    return _mm256_sllv_epi64(_mm256_set1_epi64x(1), bit);
+  }
+#endif
+};
+
+////////////////
+// xor_filter //
+////////////////
+
+template<std::unsigned_integral Fingerprint = std::uint8_t,
+         typename Allocator = std::allocator<std::uint64_t>>
+struct xor_filter
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using key_type = std::uint64_t;
+  using fingerprint_type = Fingerprint;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static_assert(sizeof(Fingerprint) <= 4, "Fingerprints come from half of a 64-bit hash.");
+
+private:
+  static constexpr size_type fingerprint_bits = std::numeric_limits<Fingerprint>::digits;
+  static constexpr size_type per_word = 64 / fingerprint_bits;
+
+  template<typename U>
+  using rebind = vector_base<U, typename AllocTraitsT::template rebind_alloc<U>>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  // The seed, then the fingerprints of three equal segments, packed per_word to a word
+  vector_base<std::uint64_t, Allocator> m_words;
+  size_type m_segment = 0;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr xor_filter() = default;
+
+  // Duplicate keys are allowed; they are removed first
+  constexpr explicit //
+    xor_filter(std::span<const key_type> keys, const Allocator& alloc = Allocator())
+    : m_words(alloc)
+  {
+    rebind<key_type> unique(keys.begin(), keys.end(), alloc);
+    unique.sort_unique();
+    const auto n = unique.size();
+
+    // 1.23 slots per key is enough for peeling to succeed with high probability
+    m_segment = (32 + n * 123 / 100 + 3 * per_word - 1) / (3 * per_word) * per_word;
+    const auto slots = 3 * m_segment;
+
+    // Per slot, how many keys hash to it and the xor of their hashes, so that a slot with a
+    // single key knows which one
+    rebind<std::uint32_t> counts(slots, alloc);
+    rebind<std::uint64_t> hashes(slots, alloc);
+    rebind<std::uint32_t> queue(alloc);
+    rebind<std::pair<std::uint64_t, std::uint32_t>> peeled(alloc);
+    queue.reserve(slots);
+    peeled.reserve(n);
+
+    for (std::uint64_t seed = 0;; ++seed) {
+      m_words.resize(1 + slots / per_word);
+      std::fill(m_words.begin(), m_words.end(), 0);
+      m_words[0] = filter_hash(seed);
+      std::fill(counts.begin(), counts.end(), 0);
+      std::fill(hashes.begin(), hashes.end(), 0);
+      queue.clear();
+      peeled.clear();
+
+      for (const auto key : unique) {
+        const auto hash = hash_of(key);
+        for (const auto slot : slots_of(hash)) {
+          ++counts[slot];
+          hashes[slot] ^= hash;
+        }
+      }
+      for (std::uint32_t slot = 0; slot < slots; ++slot) {
+        if (counts[slot] == 1) {
+          queue.push_back(slot);
+        }
+      }
+      // Peels keys alone in a slot until none are left, or only cycles remain
+      while (not queue.empty()) {
+        const auto slot = queue.back();
+        queue.pop_back();
+        if (counts[slot] != 1) {
+          continue;
+        }
+        const auto hash = hashes[slot];
+        peeled.emplace_back(hash, slot);
+        for (const auto other : slots_of(hash)) {
+          hashes[other] ^= hash;
+          if (--counts[other] == 1) {
+            queue.push_back(other);
+          }
+        }
+      }
+      if (peeled.size() == n) {
+        break;
+      }
+    }
+
+    // In reverse peeling order, each key's slot is the last of its three to be assigned
+    for (auto it = peeled.end(); it != peeled.begin();) {
+      const auto [hash, slot] = *--it;
+      const auto [a, b, c] = slots_of(hash);
+      set(slot, fingerprint_of(hash) ^ get(a) ^ get(b) ^ get(c));
+    }
+  }
+
+  // Rebuilds a filter from the words of data()
+  [[nodiscard]] static constexpr //
+    xor_filter
+    from_words(std::span<const std::uint64_t> words, const Allocator& alloc = Allocator())
+  {
+    xor_filter filter;
+    filter.m_words = vector_base<std::uint64_t, Allocator>(words.begin(), words.end(), alloc);
+    filter.m_segment = words.empty() ? 0 : (words.size() - 1) * per_word / 3;
+    return filter;
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type slot_count() const noexcept { return 3 * m_segment; }
+
+  [[nodiscard]] constexpr //
+    std::span<const std::uint64_t>
+    data() //
+    const noexcept
+  {
+    return as_span(m_words);
+  }
+
+  [[nodiscard]] constexpr //
+    bool
+    contains(key_type key) //
+    const noexcept
+  {
+    if (m_segment == 0) {
+      return false;
+    }
+    const auto hash = hash_of(key);
+    const auto [a, b, c] = slots_of(hash);
+    return fingerprint_of(hash) == (get(a) ^ get(b) ^ get(c));
+  }
+
+  constexpr //
+    size_type
+    contains_each(std::span<const key_type> keys, std::span<bool> out) //
+    const noexcept
+  {
+    size_type positives = 0;
+    for (size_type i = 0; i < keys.size(); ++i) {
+      if (not std::is_constant_evaluated() and m_segment != 0 and
+          i + filter_prefetch_distance < keys.size()) {
+        for (const auto slot : slots_of(hash_of(keys[i + filter_prefetch_distance]))) {
+          __builtin_prefetch(m_words.data() + 1 + slot / per_word);
+        }
+      }
+      out[i] = contains(keys[i]);
+      positives += out[i];
+    }
+    return positives;
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    std::uint64_t
+    hash_of(key_type key) //
+    const noexcept
+  {
+    return filter_hash(key + m_words[0]);
+  }
+
+  [[nodiscard]] static constexpr //
+    Fingerprint
+    fingerprint_of(std::uint64_t hash) //
+    noexcept
+  {
+    return static_cast<Fingerprint>(hash ^ (hash >> 32));
+  }
+
+  // One slot in each segment, from three rotations of the hash
+  [[nodiscard]] constexpr //
+    std::array<std::uint32_t, 3>
+    slots_of(std::uint64_t hash) //
+    const noexcept
+  {
+    const auto slot = [&](int rotation, size_type segment) {
+      const auto h = static_cast<std::uint32_t>(std::rotl(hash, rotation));
+      return static_cast<std::uint32_t>(filter_reduce(h, m_segment) + segment * m_segment);
+    };
+    return { slot(0, 0), slot(21, 1), slot(42, 2) };
+  }
+
+  [[nodiscard]] constexpr //
+    Fingerprint
+    get(size_type slot) //
+    const noexcept
+  {
+    const auto shift = slot % per_word * fingerprint_bits;
+    return static_cast<Fingerprint>(m_words[1 + slot / per_word] >> shift);
+  }
+
+  // Slots are assigned once, starting from zero
+  constexpr //
+    void
+    set(size_type slot, Fingerprint fingerprint) //
+    noexcept
+  {
+    const auto shift = slot % per_word * fingerprint_bits;
+    m_words[1 + slot / per_word] |= std::uint64_t{ fingerprint } << shift;
+  }
+};
+
+} // namespace constexpr_containers
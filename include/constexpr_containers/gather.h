@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Index-driven data movement over contiguous storage.
+//
+// Synopsis:
+//
+// gather(in, indices, out)
+//   out[i] = in[indices[i]] for every i < indices.size()
+// scatter(in, indices, out)
+//   out[indices[i]] = in[i] for every i < indices.size(); the last write to an element wins
+// gather_blocked(in, indices, out, block_bytes), scatter_blocked(in, indices, out, block_bytes)
+//   Like the above, but radix partition the accesses by blocks of block_bytes first, so that
+//   each block is only touched while it sits in cache. This trades random misses for extra
+//   sequential passes and scratch space, which only pays off once the arrays are far larger than
+//   the last level cache or the TLB reach; see bench/gather.cc.
+// apply_permutation(data, perm)
+//   In place version of gather: data[i] becomes the old data[perm[i]]. perm must be a
+//   permutation of [0, data.size()). Small inputs follow the cycles of perm with a visited bitmap,
+//   large ones gather through a scratch buffer, which is several times faster.
+//
+// The span overloads are the kernels. The vector_base overloads resize out to fit: to the number
+// of indices for gathers, and for scatters, up to the largest index when out is smaller.
+// At runtime, 4 and 8 byte trivially copyable elements use AVX-512 / AVX2 gathers and scatters
+// when the compiler targets them, and every kernel prefetches ahead once the randomly accessed
+// side outgrows prefetch_threshold_bytes.
+
+// How far ahead, in elements, the kernels prefetch randomly accessed elements
+inline constexpr std::size_t prefetch_distance = 32;
+// Below this size the randomly accessed side is assumed to be cache resident
+inline constexpr std::size_t prefetch_threshold_bytes = std::size_t{ 1 } << 20;
+
+template<typename T, typename Index>
+concept simd_gatherable = std::is_trivially_copyable_v<T> and (sizeof(T) == 4 or sizeof(T) == 8) and
+                          std::integral<Index> and (sizeof(Index) == 4 or sizeof(Index) == 8);
+
+////////////
+// gather //
+////////////
+
+#if defined(__AVX2__)
+// Gathers one vector worth of elements starting at indices[0], returns how many it handled
+template<typename T, typename Index>
+inline //
+  std::size_t
+  gather_vector(const T* in, const Index* indices, T* out) //
+  noexcept
+{
+  const auto* base = reinterpret_cast<const void*>(in);
+#if defined(__AVX512F__)
+  // The masked forms with a zero source keep GCC from warning about the unmasked ones
+  const auto* idx = reinterpret_cast<const void*>(indices);
+  const auto zero = _mm512_setzero_si512();
+  if constexpr (sizeof(T) == 4 and sizeof(Index) == 4) {
+    const auto i = _mm512_loadu_si512(idx);
+    _mm512_storeu_si512(out, _mm512_mask_i32gather_epi32(zero, 0xFFFF, i, base, 4));
+    return 16;
+  } else if constexpr (sizeof(T) == 8 and sizeof(Index) == 4) {
+    const auto i = _mm256_loadu_si256(static_cast<const __m256i*>(idx));
+    _mm512_storeu_si512(out, _mm512_mask_i32gather_epi64(zero, 0xFF, i, base, 8));
+    return 8;
+  } else if constexpr (sizeof(T) == 4 and sizeof(Index) == 8) {
+    const auto i = _mm512_loadu_si512(idx);
+    const auto v = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), 0xFF, i, base, 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    return 8;
+  } else {
+    const auto i = _mm512_loadu_si512(idx);
+    _mm512_storeu_si512(out, _mm512_mask_i64gather_epi64(zero, 0xFF, i, base, 8));
+    return 8;
+  }
+#else
+  const auto* idx = reinterpret_cast<const __m256i*>(indices);
+  if constexpr (sizeof(T) == 4 and sizeof(Index) == 4) {
+    const auto v =
+      _mm256_i32gather_epi32(static_cast<const int*>(base), _mm256_loadu_si256(idx), 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    return 8;
+  } else if constexpr (sizeof(T) == 8 and sizeof(Index) == 4) {
+    const auto i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices));
+    const auto v = _mm256_i32gather_epi64(static_cast<const long long*>(base), i, 8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    return 4;
+  } else if constexpr (sizeof(T) == 4 and sizeof(Index) == 8) {
+    const auto v =
+      _mm256_i64gather_epi32(static_cast<const int*>(base), _mm256_loadu_si256(idx), 4);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+    return 4;
+  } else {
+    const auto v =
+      _mm256_i64gather_epi64(static_cast<const long long*>(base), _mm256_loadu_si256(idx), 8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    return 4;
+  }
+#endif
+}
+#endif
+
+template<typename T, std::integral Index>
+constexpr //
+  void
+  gather(std::span<const T> in, std::span<const Index> indices, std::span<T> out)
+{
+  const auto n = std::min(indices.size(), out.size());
+  std::size_t i = 0;
+  if (not std::is_constant_evaluated()) {
+    const bool prefetch = in.size() * sizeof(T) >= prefetch_threshold_bytes;
+#if defined(__AVX2__)
+    if constexpr (simd_gatherable<T, Index>) {
+      // Hardware gathers take signed indices
+      const bool fits =
+        sizeof(Index) == 8 or in.size() <= std::size_t(std::numeric_limits<int>::max());
+      while (fits and i + 16 <= n) {
+        if (prefetch and i + prefetch_distance + 16 <= n) {
+          for (std::size_t j = 0; j < 16; ++j) {
+            __builtin_prefetch(in.data() + indices[i + prefetch_distance + j]);
+          }
+        }
+        const auto end = i + 16;
+        while (i < end) {
+          i += gather_vector(in.data(), indices.data() + i, out.data() + i);
+        }
+      }
+    }
+#endif
+    for (; prefetch and i + prefetch_distance < n; ++i) {
+      __builtin_prefetch(in.data() + indices[i + prefetch_distance]);
+      out[i] = in[indices[i]];
+    }
+  }
+  for (; i < n; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+/////////////
+// scatter //
+/////////////
+
+template<typename T, std::integral Index>
+constexpr //
+  void
+  scatter(std::span<const T> in, std::span<const Index> indices, std::span<T> out)
+{
+  const auto n = std::min(indices.size(), in.size());
+  std::size_t i = 0;
+  if (not std::is_constant_evaluated()) {
+    const bool prefetch = out.size() * sizeof(T) >= prefetch_threshold_bytes;
+#if defined(__AVX512F__)
+    if constexpr (simd_gatherable<T, Index>) {
+      // Scatters write lanes in order, so the last write to an element still wins
+      const bool fits =
+        sizeof(Index) == 8 or out.size() <= std::size_t(std::numeric_limits<int>::max());
+      constexpr std::size_t width = 64 / std::max(sizeof(T), sizeof(Index));
+      for (; fits and i + width <= n; i += width) {
+        if (prefetch and i + prefetch_distance + width <= n) {
+          for (std::size_t j = 0; j < width; ++j) {
+            __builtin_prefetch(out.data() + indices[i + prefetch_distance + j], 1);
+          }
+        }
+        auto* base = reinterpret_cast<void*>(out.data());
+        const auto* src = in.data() + i;
+        const auto* idx = indices.data() + i;
+        if constexpr (sizeof(T) == 4 and sizeof(Index) == 4) {
+          _mm512_i32scatter_epi32(base, _mm512_loadu_si512(idx), _mm512_loadu_si512(src), 4);
+        } else if constexpr (sizeof(T) == 8 and sizeof(Index) == 4) {
+          const auto i32 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx));
+          _mm512_i32scatter_epi64(base, i32, _mm512_loadu_si512(src), 8);
+        } else if constexpr (sizeof(T) == 4 and sizeof(Index) == 8) {
+          const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+          _mm512_i64scatter_epi32(base, _mm512_loadu_si512(idx), v, 4);
+        } else {
+          _mm512_i64scatter_epi64(base, _mm512_loadu_si512(idx), _mm512_loadu_si512(src), 8);
+        }
+      }
+    }
+#endif
+    for (; prefetch and i + prefetch_distance < n; ++i) {
+      __builtin_prefetch(out.data() + indices[i + prefetch_distance], 1);
+      out[indices[i]] = in[i];
+    }
+  }
+  for (; i < n; ++i) {
+    out[indices[i]] = in[i];
+  }
+}
+
+////////////////////////////////////
+// Cache-blocked gather / scatter //
+////////////////////////////////////
+
+template<typename Index, typename T>
+struct indexed_value
+{
+  Index index;
+  T value;
+};
+
+// Stable counting sort of make(0), ..., make(n - 1) into dst by key(i) / block_elems
+template<typename Elem, typename Key, typename Make>
+constexpr //
+  void
+  partition_by_block(std::size_t n,
+                     Key key,
+                     Make make,
+                     std::size_t block_elems,
+                     std::size_t blocks,
+                     std::span<Elem> dst)
+{
+  vector_base<std::size_t, std::allocator<std::size_t>> cursors(blocks, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    ++cursors[key(i) / block_elems];
+  }
+  std::size_t start = 0;
+  for (auto& cursor : cursors) {
+    start += std::exchange(cursor, start);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[cursors[key(i) / block_elems]++] = make(i);
+  }
+}
+
+template<typename T, std::integral Index>
+constexpr //
+  void
+  gather_blocked(std::span<const T> in,
+                 std::span<const Index> indices,
+                 std::span<T> out,
+                 std::size_t block_bytes = prefetch_threshold_bytes)
+{
+  const auto n = std::min(indices.size(), out.size());
+  const auto block_elems = std::max<std::size_t>(block_bytes / sizeof(T), 1);
+  const auto blocks = (std::max(in.size(), n) + block_elems - 1) / block_elems;
+  // Positions in out are stored as Index too, so they must fit
+  if (blocks <= 1 or n - 1 > std::size_t(std::numeric_limits<Index>::max()) or
+      not std::default_initializable<T>) {
+    return gather(in, indices, out);
+  }
+  if constexpr (std::default_initializable<T>) {
+    using Request = indexed_value<Index, Index>;
+    using Reply = indexed_value<Index, T>;
+    // Group the (position, source) requests by source block...
+    vector_base<Request, std::allocator<Request>> requests(n);
+    partition_by_block<Request>(
+      n,
+      [&](std::size_t i) { return static_cast<std::size_t>(indices[i]); },
+      [&](std::size_t i) { return Request{ static_cast<Index>(i), indices[i] }; },
+      block_elems,
+      blocks,
+      as_span(requests));
+    // ...answer them while that block is in cache, grouping the replies by destination block...
+    vector_base<Reply, std::allocator<Reply>> replies(n);
+    partition_by_block<Reply>(
+      n,
+      [&](std::size_t k) { return static_cast<std::size_t>(requests[k].index); },
+      [&](std::size_t k) { return Reply{ requests[k].index, in[requests[k].value] }; },
+      block_elems,
+      blocks,
+      as_span(replies));
+    // ...and write them while the destination block is in cache
+    for (const auto& reply : replies) {
+      out[reply.index] = reply.value;
+    }
+  }
+}
+
+template<typename T, std::integral Index>
+constexpr //
+  void
+  scatter_blocked(std::span<const T> in,
+                  std::span<const Index> indices,
+                  std::span<T> out,
+                  std::size_t block_bytes = prefetch_threshold_bytes)
+{
+  const auto n = std::min(indices.size(), in.size());
+  const auto block_elems = std::max<std::size_t>(block_bytes / sizeof(T), 1);
+  const auto blocks = (out.size() + block_elems - 1) / block_elems;
+  if (blocks <= 1 or not std::default_initializable<T>) {
+    return scatter(in, indices, out);
+  }
+  if constexpr (std::default_initializable<T>) {
+    using Write = indexed_value<Index, T>;
+    // The partition is stable, so the last write to an element still wins
+    vector_base<Write, std::allocator<Write>> writes(n);
+    partition_by_block<Write>(
+      n,
+      [&](std::size_t i) { return static_cast<std::size_t>(indices[i]); },
+      [&](std::size_t i) { return Write{ indices[i], in[i] }; },
+      block_elems,
+      blocks,
+      as_span(writes));
+    for (const auto& write : writes) {
+      out[write.index] = write.value;
+    }
+  }
+}
+
+///////////////////////
+// apply_permutation //
+///////////////////////
+
+template<typename T, std::integral Index>
+constexpr //
+  void
+  apply_permutation(std::span<T> data, std::span<const Index> perm)
+{
+  const auto n = std::min(data.size(), perm.size());
+
+  if (not std::is_constant_evaluated() and n * sizeof(T) >= prefetch_threshold_bytes) {
+    if constexpr (std::is_nothrow_move_constructible_v<T>) {
+      // Following cycles through memory serializes on every miss, so large inputs are gathered
+      // into scratch space instead, where the misses can overlap
+      vector_base<T, std::allocator<T>> scratch;
+      scratch.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        if (i + prefetch_distance < n) {
+          __builtin_prefetch(data.data() + perm[i + prefetch_distance]);
+        }
+        scratch.push_back(std::move(data[perm[i]]));
+      }
+      std::move(scratch.begin(), scratch.end(), data.begin());
+      return;
+    }
+  }
+
+  vector_base<std::uint64_t, std::allocator<std::uint64_t>> done((n + 63) / 64, 0);
+  for (std::size_t start = 0; start < n; ++start) {
+    if (done[start / 64] >> (start % 64) & 1) {
+      continue;
+    }
+    // Walk the cycle through start, pulling every element into place
+    T tmp = std::move(data[start]);
+    auto i = start;
+    for (;;) {
+      done[i / 64] |= std::uint64_t{ 1 } << (i % 64);
+      const auto next = static_cast<std::size_t>(perm[i]);
+      if (next == start) {
+        data[i] = std::move(tmp);
+        break;
+      }
+      data[i] = std::move(data[next]);
+      i = next;
+    }
+  }
+}
+
+///////////////////////////
+// vector_base overloads //
+///////////////////////////
+
+// Grows out, keeping its elements, until every index is in range
+template<typename T, typename OutAlloc, std::integral Index, typename IndexAlloc>
+constexpr //
+  void
+  resize_for_indices(vector_base<T, OutAlloc>& out, const vector_base<Index, IndexAlloc>& indices)
+{
+  if (not indices.empty()) {
+    const auto last = static_cast<std::size_t>(*std::max_element(indices.begin(), indices.end()));
+    if (last >= out.size()) {
+      out.resize(last + 1);
+    }
+  }
+}
+
+template<typename T, typename Alloc, std::integral Index, typename IndexAlloc, typename OutAlloc>
+constexpr //
+  void
+  gather(const vector_base<T, Alloc>& in,
+         const vector_base<Index, IndexAlloc>& indices,
+         vector_base<T, OutAlloc>& out)
+{
+  out.resize(indices.size());
+  gather(as_span(in), as_span(indices), as_span(out));
+}
+
+template<typename T, typename Alloc, std::integral Index, typename IndexAlloc, typename OutAlloc>
+constexpr //
+  void
+  scatter(const vector_base<T, Alloc>& in,
+          const vector_base<Index, IndexAlloc>& indices,
+          vector_base<T, OutAlloc>& out)
+{
+  resize_for_indices(out, indices);
+  scatter(as_span(in), as_span(indices), as_span(out));
+}
+
+template<typename T, typename Alloc, std::integral Index, typename IndexAlloc, typename OutAlloc>
+constexpr //
+  void
+  gather_blocked(const vector_base<T, Alloc>& in,
+                 const vector_base<Index, IndexAlloc>& indices,
+                 vector_base<T, OutAlloc>& out,
+                 std::size_t block_bytes = prefetch_threshold_bytes)
+{
+  out.resize(indices.size());
+  gather_blocked(as_span(in), as_span(indices), as_span(out), block_bytes);
+}
+
+template<typename T, typename Alloc, std::integral Index, typename IndexAlloc, typename OutAlloc>
+constexpr //
+  void
+  scatter_blocked(const vector_base<T, Alloc>& in,
+                  const vector_base<Index, IndexAlloc>& indices,
+                  vector_base<T, OutAlloc>& out,
+                  std::size_t block_bytes = prefetch_threshold_bytes)
+{
+  resize_for_indices(out, indices);
+  scatter_blocked(as_span(in), as_span(indices), as_span(out), block_bytes);
+}
+
+template<typename T, typename Alloc, std::integral Index, typename IndexAlloc>
+constexpr //
+  void
+  apply_permutation(vector_base<T, Alloc>& data, const vector_base<Index, IndexAlloc>& perm)
+{
+  apply_permutation(as_span(data), as_span(perm));
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Coroutine generators, and their collection into a vector_base without a push_back per element.
+//
+// Synopsis:
+//
+// generator<T>
+//   A coroutine that co_yields values of T, read through its input range (begin() resumes it up
+//   to the first value). Exceptions thrown by the coroutine propagate out of the resumption.
+//   co_yield size_hint{ n } tells collectors to expect about n more elements, without suspending,
+//   read back through hinted_size(). A default-constructed or moved-from generator is empty
+// batch_generator<T>
+//   A generator<std::span<const T>>, which co_yields whole batches to amortize the cost of a
+//   resumption over many elements. Spans only need to stay valid until the next resumption
+// collect_into(gen, out)
+//   Appends every value of a generator, or every element of a batch_generator, to out, and
+//   returns their number. Capacity is reserved once from the size hint, if any, then grows
+//   geometrically. Trivially copyable elements are written straight into the spare capacity, a
+//   batch at a time. Nothing is appended if the generator throws
+
+struct size_hint
+{
+  std::size_t size;
+};
+
+// Room made for collected elements at once when nothing hints at how many there are
+inline constexpr std::size_t min_collect_batch = 64;
+
+template<typename T>
+struct generator
+{
+  struct promise_type
+  {
+    const T* m_value = nullptr;
+    std::size_t m_size_hint = 0;
+    std::exception_ptr m_error;
+
+    generator get_return_object() noexcept
+    {
+      return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() /***/ noexcept { return {}; }
+    std::suspend_always final_suspend() /*****/ noexcept { return {}; }
+    void return_void() /**********************/ noexcept {}
+    void unhandled_exception() /**************/ noexcept { m_error = std::current_exception(); }
+
+    // The value lives in the coroutine frame, or is a temporary of the co_yield expression, until
+    // the next resumption
+    std::suspend_always yield_value(const T& value) noexcept
+    {
+      m_value = std::addressof(value);
+      return {};
+    }
+
+    std::suspend_never yield_value(size_hint hint) noexcept
+    {
+      m_size_hint = hint.size;
+      return {};
+    }
+
+    // Generators only yield
+    template<typename U>
+    std::suspend_never await_transform(U&&) = delete;
+  };
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  struct iterator
+  {
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    handle_type m_coro;
+
+    const T& operator*() const noexcept { return *m_coro.promise().m_value; }
+
+    bool operator==(std::default_sentinel_t) const noexcept
+    {
+      return not m_coro or m_coro.done();
+    }
+
+    iterator& operator++()
+    {
+      resume(m_coro);
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+  };
+
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  generator() noexcept = default;
+
+  explicit                      //
+    generator(handle_type coro) //
+    noexcept
+    : m_coro(coro)
+  {}
+
+  generator(generator&& other) noexcept
+    : m_coro(std::exchange(other.m_coro, {}))
+  {}
+
+  generator& operator=(generator&& other) noexcept
+  {
+    if (this != &other) {
+      destroy();
+      m_coro = std::exchange(other.m_coro, {});
+    }
+    return *this;
+  }
+
+  ~generator() { destroy(); }
+
+  ///////////////
+  // Iterators //
+  ///////////////
+
+  // Starts the coroutine, so only once
+  iterator begin()
+  {
+    if (m_coro) {
+      resume(m_coro);
+    }
+    return iterator{ m_coro };
+  }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  // The last size hint yielded, 0 if none
+  [[nodiscard]] std::size_t hinted_size() const noexcept
+  {
+    return m_coro ? m_coro.promise().m_size_hint : 0;
+  }
+
+private:
+  static void resume(handle_type coro)
+  {
+    coro.resume();
+    if (coro.promise().m_error) {
+      std::rethrow_exception(std::exchange(coro.promise().m_error, nullptr));
+    }
+  }
+
+  void destroy() noexcept
+  {
+    if (m_coro) {
+      m_coro.destroy();
+    }
+  }
+
+  handle_type m_coro = nullptr;
+};
+
+template<typename T>
+using batch_generator = generator<std::span<const T>>;
+
+// Makes room for at least count more elements, doubling the capacity when it runs out
+template<typename T, typename Alloc>
+void
+grow_for(vector_base<T, Alloc>& out, std::size_t count)
+{
+  if (count > out.capacity() - out.size()) {
+    out.reserve(std::max(out.size() + count, out.size() * 2));
+  }
+}
+
+template<typename T, typename Alloc>
+std::size_t
+collect_into(generator<T> gen, vector_base<T, Alloc>& out)
+{
+  const auto start = out.size();
+  try {
+    auto it = gen.begin();
+    if (gen.hinted_size() > 0) {
+      out.reserve(out.size() + gen.hinted_size());
+    }
+    if constexpr (std::is_trivially_copyable_v<T> and
+                  std::is_trivially_default_constructible_v<T>) {
+      while (it != gen.end()) {
+        // Fills all of the spare capacity, which the hint may have sized exactly
+        if (out.capacity() == out.size()) {
+          grow_for(out, std::max(out.size(), min_collect_batch));
+        }
+        out.append_uninitialized(out.capacity() - out.size(), [&](T* dst, std::size_t count) {
+          std::size_t i = 0;
+          for (; i < count and it != gen.end(); ++i, ++it) {
+            dst[i] = *it;
+          }
+          return i;
+        });
+      }
+    } else {
+      for (; it != gen.end(); ++it) {
+        out.push_back(*it);
+      }
+    }
+  } catch (...) {
+    while (out.size() > start) {
+      out.pop_back();
+    }
+    throw;
+  }
+  return out.size() - start;
+}
+
+template<typename T, typename Alloc>
+std::size_t
+collect_into(batch_generator<T> gen, vector_base<T, Alloc>& out)
+{
+  const auto start = out.size();
+  try {
+    auto it = gen.begin();
+    if (gen.hinted_size() > 0) {
+      out.reserve(out.size() + gen.hinted_size());
+    }
+    for (; it != gen.end(); ++it) {
+      const auto batch = *it;
+      grow_for(out, batch.size());
+      if constexpr (std::is_trivially_copyable_v<T> and
+                    std::is_trivially_default_constructible_v<T>) {
+        out.append_uninitialized(batch.size(), [&](T* dst, std::size_t count) {
+          std::copy(batch.begin(), batch.end(), dst);
+          return count;
+        });
+      } else {
+        for (const auto& value : batch) {
+          out.push_back(value);
+        }
+      }
+    }
+  } catch (...) {
+    while (out.size() > start) {
+      out.pop_back();
+    }
+    throw;
+  }
+  return out.size() - start;
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "constexpr_containers/uring.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Bulk loading of trivially copyable elements into a vector_base, straight from the kernel or the
+// stream buffer into the spare capacity, without value-initializing it first nor going through
+// an intermediate buffer. Capacity is reserved once when the input size is known (regular files,
+// file streams), and grows geometrically otherwise (pipes, sockets, string streams). Writing
+// goes the other way without a staging buffer either: the kernel gathers the bytes of many
+// vectors itself.
+//
+// Synopsis:
+//
+// read_into(fd, out, bytes = all)
+//   Appends up to bytes bytes read from fd at its file offset, which it advances, stopping early
+//   at end of file. Returns the number of elements appended
+// read_into(fd, out, bytes, offset)
+//   Likewise with pread from offset, leaving the file offset of fd untouched, so that threads
+//   can share fd
+// append_from(is, out, bytes = all)
+//   Appends up to bytes bytes read from the istream is, stopping early at end of file, which sets
+//   eofbit. Returns the number of elements appended
+//
+// vectored_writer(fd, offset, backend)
+//   flush() writes the vectors and byte spans passed to add() since the last flush, back to back,
+//   with one gathering write per max_iovecs of them: from offset with pwritev, or with as many
+//   io_uring writes in flight as the ring holds, or at the file offset of fd with writev when
+//   offset is -1. Spans are not copied, so they must stay alive and unchanged until flush()
+//   returns. The io_uring backend is picked when available, unless backend says otherwise. A
+//   flush that throws drops what was added, and leaves offset() where it was
+//
+// The size of regular files and seekable streams is only used to reserve, so files that report
+// no size, like those of procfs, or that grow while being read, are read to their actual end.
+// Sizes in bytes must be multiples of sizeof(T), and input ending inside an element throws
+// std::runtime_error. Failed system calls throw std::system_error. Either way, nothing is
+// appended. File descriptors are hinted with POSIX_FADV_SEQUENTIAL, which doubles readahead.
+
+inline constexpr std::size_t all_bytes = std::numeric_limits<std::size_t>::max();
+
+// Upper bound on each read, large enough to amortize system calls, small enough to keep each one
+// interruptible
+inline constexpr std::size_t io_block_bytes = std::size_t{ 1 } << 24;
+
+// Appends the elements read by read(dst, n), which returns how many of the n bytes it wrote to dst
+// and 0 at end of input. known_bytes is the size of the input when known, all_bytes otherwise
+template<typename T, typename Alloc, typename Read>
+std::size_t
+append_blocks(vector_base<T, Alloc>& out, std::size_t bytes, std::size_t known_bytes, Read read)
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Elements are read as bytes.");
+  if (bytes % sizeof(T) != 0 and bytes != all_bytes) {
+    throw std::invalid_argument("Byte count is not a multiple of the element size.");
+  }
+  const auto start = out.size();
+  auto remaining = bytes == all_bytes ? all_bytes : bytes / sizeof(T);
+  bool more = true;
+  // Reads whole elements into [dst, dst + n) until end of input
+  const auto fill = [&](T* dst, std::size_t n) {
+    auto* const first = reinterpret_cast<std::byte*>(dst);
+    const auto total = n * sizeof(T);
+    std::size_t done = 0;
+    while (done < total) {
+      const auto got = read(first + done, std::min(total - done, io_block_bytes));
+      if (got == 0) {
+        more = false;
+        break;
+      }
+      done += got;
+    }
+    if (done % sizeof(T) != 0) {
+      throw std::runtime_error("Input ends inside an element.");
+    }
+    return done / sizeof(T);
+  };
+  try {
+    // The known size only sizes the first block: procfs and sysfs report 0 bytes, and files can
+    // grow while being read, so reading goes on until the end of input
+    if (known_bytes != all_bytes) {
+      remaining -= out.append_uninitialized(std::min(remaining, known_bytes / sizeof(T)), fill);
+      if (more and remaining > 0) {
+        // Usually just the end of input, found without growing the vector
+        T next;
+        const auto got = fill(std::addressof(next), 1);
+        if (got != 0) {
+          out.push_back(next);
+          --remaining;
+        }
+      }
+    }
+    while (more and remaining > 0) {
+      // Doubling from one block
+      const auto count = std::min(remaining, std::max(out.size(), io_block_bytes / sizeof(T)));
+      remaining -= out.append_uninitialized(count, fill);
+    }
+  } catch (...) {
+    out.resize(start);
+    throw;
+  }
+  return out.size() - start;
+}
+
+// Bytes from offset to the end of a regular file, all_bytes for other kinds of files
+inline std::size_t
+bytes_until_end(int fd, off_t offset)
+{
+  struct stat st;
+  if (offset < 0 or ::fstat(fd, &st) != 0 or not S_ISREG(st.st_mode)) {
+    return all_bytes;
+  }
+  return st.st_size > offset ? static_cast<std::size_t>(st.st_size - offset) : 0;
+}
+
+inline void
+advise_sequential(int fd, off_t offset, std::size_t bytes)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+  if (offset >= 0) {
+    // Only a hint, so failures (on pipes, for one) are ignored
+    const auto len = bytes == all_bytes ? off_t{ 0 } : static_cast<off_t>(bytes);
+    static_cast<void>(::posix_fadvise(fd, offset, len, POSIX_FADV_SEQUENTIAL));
+  }
+#else
+  static_cast<void>(fd);
+  static_cast<void>(offset);
+  static_cast<void>(bytes);
+#endif
+}
+
+// Retries system calls interrupted by signals, and throws on failure
+template<typename Call>
+std::size_t
+retry_io(Call call, const char* what)
+{
+  for (;;) {
+    const auto got = call();
+    if (got >= 0) {
+      return static_cast<std::size_t>(got);
+    }
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+  }
+}
+
+template<typename T, typename Alloc>
+std::size_t
+read_into(int fd, vector_base<T, Alloc>& out, std::size_t bytes = all_bytes)
+{
+  // Not seekable, like pipes, gives -1, which skips both the hint and the size
+  const auto offset = ::lseek(fd, 0, SEEK_CUR);
+  advise_sequential(fd, offset, bytes);
+  const auto known = bytes_until_end(fd, offset);
+  return append_blocks(out, bytes, known, [&](std::byte* dst, std::size_t n) {
+    return retry_io([&] { return ::read(fd, dst, n); }, "read");
+  });
+}
+
+template<typename T, typename Alloc>
+std::size_t
+read_into(int fd, vector_base<T, Alloc>& out, std::size_t bytes, off_t offset)
+{
+  advise_sequential(fd, offset, bytes);
+  const auto known = bytes_until_end(fd, offset);
+  return append_blocks(out, bytes, known, [&](std::byte* dst, std::size_t n) {
+    const auto got = retry_io([&] { return ::pread(fd, dst, n, offset); }, "pread");
+    offset += static_cast<off_t>(got);
+    return got;
+  });
+}
+
+template<typename T, typename Alloc>
+std::size_t
+append_from(std::istream& is, vector_base<T, Alloc>& out, std::size_t bytes = all_bytes)
+{
+  const std::istream::sentry ok(is, true);
+  if (not ok) {
+    return 0;
+  }
+  // Seekable buffers give the size of the rest, and file buffers read large requests past their
+  // own buffer
+  auto* const buf = is.rdbuf();
+  auto known = all_bytes;
+  const auto here = buf->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+  if (here != std::streampos(-1)) {
+    const auto end = buf->pubseekoff(0, std::ios_base::end, std::ios_base::in);
+    buf->pubseekpos(here, std::ios_base::in);
+    if (end != std::streampos(-1)) {
+      known = static_cast<std::size_t>(std::max(std::streamoff{ 0 }, std::streamoff(end - here)));
+    }
+  }
+  bool eof = false;
+  const auto appended = append_blocks(out, bytes, known, [&](std::byte* dst, std::size_t n) {
+    const auto got = static_cast<std::size_t>(
+      buf->sgetn(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n)));
+    eof = got == 0;
+    return got;
+  });
+  if (eof or (bytes == all_bytes and known != all_bytes)) {
+    is.setstate(std::ios_base::eofbit);
+  }
+  return appended;
+}
+
+/////////////////////
+// vectored_writer //
+/////////////////////
+
+#if defined(IOV_MAX)
+inline constexpr std::size_t max_iovecs = IOV_MAX;
+#else
+// The least POSIX allows
+inline constexpr std::size_t max_iovecs = 16;
+#endif
+
+enum class io_backend
+{
+  // io_uring when the kernel allows it and there is an offset, system calls otherwise
+  automatic,
+  system_calls,
+  io_uring,
+};
+
+struct vectored_writer
+{
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  explicit vectored_writer(int fd, off_t offset = -1, io_backend backend = io_backend::automatic)
+    : m_fd(fd)
+    , m_offset(offset)
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    const bool wanted =
+      backend == io_backend::io_uring or (backend == io_backend::automatic and uring::available());
+    if (wanted and offset >= 0) {
+      m_ring = std::make_unique<uring>(ring_entries);
+    }
+#endif
+    if (backend == io_backend::io_uring and not uses_io_uring()) {
+      throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                              "io_uring needs kernel support and an offset");
+    }
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] off_t offset() /*********/ const noexcept { return m_offset; }
+  [[nodiscard]] std::size_t pending() /**/ const noexcept { return m_pending; }
+
+  [[nodiscard]] //
+    bool
+    uses_io_uring() //
+    const noexcept
+  {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+    return m_ring != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  void add(std::span<const std::byte> bytes)
+  {
+    if (not bytes.empty()) {
+      m_iovecs.push_back({ const_cast<std::byte*>(bytes.data()), bytes.size() });
+      m_pending += bytes.size();
+    }
+  }
+
+  template<typename T, typename Alloc>
+  void add(const vector_base<T, Alloc>& c)
+  {
+    add(as_bytes(c));
+  }
+
+  // Writes everything added since the last flush, and returns the number of bytes written
+  std::size_t flush()
+  {
+    const auto written = m_pending;
+    try {
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+      if (m_ring) {
+        flush_ring();
+      } else {
+        write_all(m_iovecs.data(), m_iovecs.size(), m_offset);
+      }
+#else
+      write_all(m_iovecs.data(), m_iovecs.size(), m_offset);
+#endif
+    } catch (...) {
+      // Some of it may be written, and write_all consumes the iovecs
+      m_iovecs.clear();
+      m_pending = 0;
+      throw;
+    }
+    if (m_offset >= 0) {
+      m_offset += static_cast<off_t>(written);
+    }
+    m_iovecs.clear();
+    m_pending = 0;
+    return written;
+  }
+
+private:
+  static constexpr unsigned ring_entries = 64;
+
+  // Writes iov[0..count) from offset, or at the file offset when it is -1, resuming after short
+  // writes. Consumes iov
+  void write_all(iovec* iov, std::size_t count, off_t offset)
+  {
+    while (count > 0) {
+      const auto batch = static_cast<int>(std::min(count, max_iovecs));
+      auto got = retry_io(
+        [&] {
+          return offset >= 0 ? ::pwritev(m_fd, iov, batch, offset) : ::writev(m_fd, iov, batch);
+        },
+        offset >= 0 ? "pwritev" : "writev");
+      if (offset >= 0) {
+        offset += static_cast<off_t>(got);
+      }
+      for (; count > 0 and got >= iov->iov_len; ++iov, --count) {
+        got -= iov->iov_len;
+      }
+      if (got > 0) {
+        iov->iov_base = static_cast<std::byte*>(iov->iov_base) + got;
+        iov->iov_len -= got;
+      }
+    }
+  }
+
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  // One write per max_iovecs iovecs, as many in flight as the ring holds. Once nothing is in
+  // flight, short writes are finished with pwritev and the first error is thrown, so that no
+  // completion is left for the next flush, whose batches would not match its user_data
+  void flush_ring()
+  {
+    struct batch
+    {
+      std::size_t first;
+      std::size_t count;
+      off_t offset;
+      std::size_t bytes;
+      std::size_t written = 0;
+      bool failed = false;
+    };
+    vector_base<batch, std::allocator<batch>> batches;
+    batches.reserve((m_iovecs.size() + max_iovecs - 1) / max_iovecs);
+    auto offset = m_offset;
+    for (std::size_t first = 0; first < m_iovecs.size(); first += max_iovecs) {
+      const auto count = std::min(max_iovecs, m_iovecs.size() - first);
+      std::size_t bytes = 0;
+      for (std::size_t i = first; i < first + count; ++i) {
+        bytes += m_iovecs[i].iov_len;
+      }
+      batches.push_back({ first, count, offset, bytes });
+      offset += static_cast<off_t>(bytes);
+    }
+
+    int error = 0;
+    std::size_t next = 0;
+    for (;;) {
+      for (; next < batches.size() and error == 0; ++next) {
+        const auto& b = batches[next];
+        if (not m_ring->prepare(IORING_OP_WRITEV, m_fd, m_iovecs.data() + b.first,
+                                static_cast<std::uint32_t>(b.count),
+                                static_cast<std::uint64_t>(b.offset), next)) {
+          break;
+        }
+      }
+      if (m_ring->in_flight() == 0) {
+        break;
+      }
+      try {
+        m_ring->submit(1);
+      } catch (...) {
+        // The writes in flight can no longer be waited for: drops the ring along with their
+        // completions, and writes with system calls from then on
+        m_ring.reset();
+        throw;
+      }
+      m_ring->reap([&](std::uint64_t index, std::int32_t result) noexcept {
+        auto& b = batches[index];
+        if (result < 0) {
+          b.failed = true;
+          error = error == 0 ? -result : error;
+        } else {
+          b.written = static_cast<std::size_t>(result);
+        }
+      });
+    }
+
+    // All the batches before next have completed
+    for (std::size_t i = 0; i < next; ++i) {
+      const auto& b = batches[i];
+      if (b.failed or b.written == b.bytes) {
+        continue;
+      }
+      // Skips what was written, then writes the rest synchronously
+      auto* iov = m_iovecs.data() + b.first;
+      auto count = b.count;
+      auto done = b.written;
+      for (; done >= iov->iov_len; ++iov, --count) {
+        done -= iov->iov_len;
+      }
+      iov->iov_base = static_cast<std::byte*>(iov->iov_base) + done;
+      iov->iov_len -= done;
+      try {
+        write_all(iov, count, b.offset + static_cast<off_t>(b.written));
+      } catch (const std::system_error&) {
+        if (error == 0) {
+          throw;
+        }
+      }
+    }
+    if (error != 0) {
+      throw std::system_error(error, std::generic_category(), "io_uring writev");
+    }
+  }
+#endif
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  int m_fd;
+  off_t m_offset;
+  std::size_t m_pending = 0;
+  vector_base<iovec, std::allocator<iovec>> m_iovecs;
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  std::unique_ptr<uring> m_ring;
+#endif
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+#include "constexpr_containers/mdspan.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Owning multi-dimensional array: a vector_base of required_span_size() elements, laid out by
+// Layout, handed out as mdspan views.
+//
+// Synopsis:
+//
+// mdarray<T, Extents, Layout, Allocator>(extents...)
+//   Value-initialized array of the given shape; the extents are either all of them or only the
+//   dynamic ones, as for extents
+// to_mdspan()
+//   A view of the elements, const for a const array, to pass to copy and transpose
+// operator()(i, j, ...)
+//   The element at the given indices
+// container()
+//   The underlying storage, including the padding of tiled layouts
+
+template<typename T,
+         typename Extents,
+         typename Layout = layout_right,
+         typename Allocator = std::allocator<T>>
+struct mdarray
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using value_type = T;
+  using extents_type = Extents;
+  using layout_type = Layout;
+  using mapping_type = typename Layout::template mapping<Extents>;
+  using index_type = typename Extents::index_type;
+  using size_type = typename Extents::size_type;
+  using rank_type = typename Extents::rank_type;
+  using allocator_type = Allocator;
+  using container_type = vector_base<T, Allocator>;
+  using mdspan_type = mdspan<T, Extents, Layout>;
+  using const_mdspan_type = mdspan<const T, Extents, Layout>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  mapping_type m_mapping;
+  container_type m_container;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr mdarray() = default;
+
+  constexpr explicit //
+    mdarray(const Extents& extents, const Allocator& alloc = Allocator())
+    : m_mapping(extents)
+    , m_container(m_mapping.required_span_size(), alloc)
+  {}
+
+  template<std::integral... Ts>
+    requires(sizeof...(Ts) != 0)
+  constexpr explicit //
+    mdarray(Ts... extents)
+    : mdarray(Extents(extents...))
+  {}
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] static constexpr rank_type rank() noexcept { return Extents::rank(); }
+
+  [[nodiscard]] constexpr const mapping_type& mapping() /***/ const noexcept { return m_mapping; }
+  [[nodiscard]] constexpr const Extents& extents() /********/ const noexcept
+  {
+    return m_mapping.extents();
+  }
+
+  [[nodiscard]] constexpr //
+    index_type
+    extent(rank_type r) //
+    const noexcept
+  {
+    return extents().extent(r);
+  }
+
+  [[nodiscard]] constexpr T* data() /*****************************/ noexcept
+  {
+    return m_container.data();
+  }
+  [[nodiscard]] constexpr const T* data() /*******************/ const noexcept
+  {
+    return m_container.data();
+  }
+  [[nodiscard]] constexpr container_type& container() /*******/ noexcept { return m_container; }
+  [[nodiscard]] constexpr const container_type& container() const noexcept { return m_container; }
+
+  [[nodiscard]] constexpr //
+    size_type
+    size() //
+    const noexcept
+  {
+    return static_cast<size_type>(extents().product(0, rank()));
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  template<std::integral... Indices>
+    requires(sizeof...(Indices) == Extents::rank())
+  [[nodiscard]] constexpr //
+    T&
+    operator()(Indices... indices) //
+    noexcept
+  {
+    return m_container[m_mapping(indices...)];
+  }
+
+  template<std::integral... Indices>
+    requires(sizeof...(Indices) == Extents::rank())
+  [[nodiscard]] constexpr //
+    const T&
+    operator()(Indices... indices) //
+    const noexcept
+  {
+    return m_container[m_mapping(indices...)];
+  }
+
+  ///////////
+  // Views //
+  ///////////
+
+  [[nodiscard]] constexpr //
+    mdspan_type
+    to_mdspan() //
+    noexcept
+  {
+    return mdspan_type(m_container.data(), m_mapping);
+  }
+
+  [[nodiscard]] constexpr //
+    const_mdspan_type
+    to_mdspan() //
+    const noexcept
+  {
+    return const_mdspan_type(m_container.data(), m_mapping);
+  }
+
+  ////////////////
+  // Comparison //
+  ////////////////
+
+  // Element-wise, ignoring any padding
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const mdarray& a, const mdarray& b)
+  {
+    if (not(a.extents() == b.extents())) {
+      return false;
+    }
+    if constexpr (mapping_type::is_always_exhaustive()) {
+      return a.m_container == b.m_container;
+    } else {
+      const auto view_a = a.to_mdspan();
+      const auto view_b = b.to_mdspan();
+      bool equal = true;
+      for_each_index(a.extents(),
+                     [&](auto... i) { equal = equal and view_a(i...) == view_b(i...); });
+      return equal;
+    }
+  }
+};
+
+} // namespace constexpr_containers
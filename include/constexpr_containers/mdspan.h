@@ -0,0 +1,502 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace constexpr_containers {
+
+// Multi-dimensional views over contiguous storage, following the interface of C++23 std::mdspan
+// (which this standard library does not ship), plus a tiled layout and blocked copy / transpose.
+// Elements are accessed with operator()(i, j, ...), as C++20 has no multi-argument operator[].
+//
+// Synopsis:
+//
+// extents<IndexType, E...>, dextents<IndexType, Rank>
+//   Shape of a view, where each E is a compile-time extent or dynamic_extent
+// layout_right, layout_left
+//   Row-major (last index contiguous) and column-major (first index contiguous)
+// layout_tiled<TileRows, TileCols>
+//   Two dimensional layout made of TileRows x TileCols tiles, each stored contiguously in
+//   row-major order, tiles themselves in row-major order. Partial tiles at the edges are padded,
+//   so the storage needed (required_span_size) may exceed the number of elements. Each tile is
+//   one contiguous block, so a blocked traversal along rows or columns stays within the memory
+//   of a few tiles.
+// mdspan<T, Extents, Layout>
+//   Non-owning view of the elements at data + mapping(i, j, ...)
+// for_each_index(extents, op)
+//   Calls op(i, j, ...) for every index, in row-major order
+// copy(src, dst)
+//   Copies the elements whose indices are valid in both views. Views of the same layout and
+//   extents are copied as one span, padding included, two dimensional ones in cache-sized blocks
+// transpose(src, dst)
+//   dst(j, i) = src(i, j) for two dimensional views, in cache-sized blocks, for the indices valid
+//   in both. Static extents that do not match once swapped fail to compile
+
+inline constexpr std::size_t dynamic_extent = std::dynamic_extent;
+
+/////////////
+// extents //
+/////////////
+
+template<std::integral IndexType, std::size_t... Extents>
+struct extents
+{
+  using index_type = IndexType;
+  using size_type = std::make_unsigned_t<IndexType>;
+  using rank_type = std::size_t;
+
+  [[nodiscard]] static constexpr rank_type rank() noexcept { return sizeof...(Extents); }
+  [[nodiscard]] static constexpr rank_type rank_dynamic() noexcept
+  {
+    return ((Extents == dynamic_extent) + ... + 0);
+  }
+
+  [[nodiscard]] static constexpr //
+    std::size_t
+    static_extent(rank_type r) //
+    noexcept
+  {
+    constexpr std::size_t all[] = { Extents..., 0 };
+    return all[r];
+  }
+
+private:
+  // Position of each extent among the dynamic ones
+  [[nodiscard]] static constexpr //
+    rank_type
+    dynamic_index(rank_type r) //
+    noexcept
+  {
+    rank_type index = 0;
+    for (rank_type i = 0; i < r; ++i) {
+      index += static_extent(i) == dynamic_extent;
+    }
+    return index;
+  }
+
+  std::array<IndexType, rank_dynamic()> m_dynamic{};
+
+public:
+  constexpr extents() = default;
+
+  // Either every extent or only the dynamic ones
+  template<std::integral... Ts>
+    requires(sizeof...(Ts) != 0 and
+             (sizeof...(Ts) == rank_dynamic() or sizeof...(Ts) == rank()))
+  constexpr explicit //
+    extents(Ts... values) //
+    noexcept
+  {
+    const IndexType given[] = { static_cast<IndexType>(values)... };
+    if constexpr (sizeof...(Ts) == rank_dynamic()) {
+      std::copy(given, given + rank_dynamic(), m_dynamic.begin());
+    } else {
+      for (rank_type r = 0; r < rank(); ++r) {
+        if (static_extent(r) == dynamic_extent) {
+          m_dynamic[dynamic_index(r)] = given[r];
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr //
+    IndexType
+    extent(rank_type r) //
+    const noexcept
+  {
+    return static_extent(r) == dynamic_extent ? m_dynamic[dynamic_index(r)] :
+                                                static_cast<IndexType>(static_extent(r));
+  }
+
+  // Product of the extents in [first, last)
+  [[nodiscard]] constexpr //
+    std::size_t
+    product(rank_type first, rank_type last) //
+    const noexcept
+  {
+    std::size_t size = 1;
+    for (; first < last; ++first) {
+      size *= static_cast<std::size_t>(extent(first));
+    }
+    return size;
+  }
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const extents& a, const extents& b) //
+    noexcept
+  {
+    return a.m_dynamic == b.m_dynamic;
+  }
+};
+
+template<typename IndexType, std::size_t... I>
+auto make_dextents(std::index_sequence<I...>) -> extents<IndexType, (I, dynamic_extent)...>;
+
+template<typename IndexType, std::size_t Rank>
+using dextents = decltype(make_dextents<IndexType>(std::make_index_sequence<Rank>()));
+
+/////////////
+// Layouts //
+/////////////
+
+struct layout_right
+{
+  template<typename Extents>
+  struct mapping
+  {
+    using extents_type = Extents;
+    using index_type = typename Extents::index_type;
+
+    Extents m_extents;
+
+    constexpr mapping() = default;
+    constexpr mapping(const Extents& e) noexcept
+      : m_extents(e)
+    {}
+
+    [[nodiscard]] constexpr const Extents& extents() const noexcept { return m_extents; }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      required_span_size() //
+      const noexcept
+    {
+      return m_extents.product(0, Extents::rank());
+    }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      stride(std::size_t r) //
+      const noexcept
+    {
+      return m_extents.product(r + 1, Extents::rank());
+    }
+
+    template<std::integral... Indices>
+    [[nodiscard]] constexpr //
+      std::size_t
+      operator()(Indices... indices) //
+      const noexcept
+    {
+      std::size_t offset = 0;
+      std::size_t r = 0;
+      ((offset = offset * static_cast<std::size_t>(m_extents.extent(r++)) +
+                 static_cast<std::size_t>(indices)),
+       ...);
+      return offset;
+    }
+
+    static constexpr bool is_always_exhaustive() noexcept { return true; }
+  };
+};
+
+struct layout_left
+{
+  template<typename Extents>
+  struct mapping
+  {
+    using extents_type = Extents;
+    using index_type = typename Extents::index_type;
+
+    Extents m_extents;
+
+    constexpr mapping() = default;
+    constexpr mapping(const Extents& e) noexcept
+      : m_extents(e)
+    {}
+
+    [[nodiscard]] constexpr const Extents& extents() const noexcept { return m_extents; }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      required_span_size() //
+      const noexcept
+    {
+      return m_extents.product(0, Extents::rank());
+    }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      stride(std::size_t r) //
+      const noexcept
+    {
+      return m_extents.product(0, r);
+    }
+
+    template<std::integral... Indices>
+    [[nodiscard]] constexpr //
+      std::size_t
+      operator()(Indices... indices) //
+      const noexcept
+    {
+      const std::size_t index[] = { static_cast<std::size_t>(indices)... };
+      std::size_t offset = 0;
+      for (auto r = sizeof...(Indices); r > 0; --r) {
+        offset = offset * static_cast<std::size_t>(m_extents.extent(r - 1)) + index[r - 1];
+      }
+      return offset;
+    }
+
+    static constexpr bool is_always_exhaustive() noexcept { return true; }
+  };
+};
+
+template<std::size_t TileRows, std::size_t TileCols>
+struct layout_tiled
+{
+  static_assert(TileRows > 0 and TileCols > 0, "Tiles cannot be empty.");
+
+  template<typename Extents>
+  struct mapping
+  {
+    static_assert(Extents::rank() == 2, "Only matrices can be tiled.");
+
+    using extents_type = Extents;
+    using index_type = typename Extents::index_type;
+
+    static constexpr std::size_t tile_size = TileRows * TileCols;
+
+    Extents m_extents;
+
+    constexpr mapping() = default;
+    constexpr mapping(const Extents& e) noexcept
+      : m_extents(e)
+    {}
+
+    [[nodiscard]] constexpr const Extents& extents() const noexcept { return m_extents; }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      tiles_per_row() //
+      const noexcept
+    {
+      return (static_cast<std::size_t>(m_extents.extent(1)) + TileCols - 1) / TileCols;
+    }
+
+    [[nodiscard]] constexpr //
+      std::size_t
+      required_span_size() //
+      const noexcept
+    {
+      const auto tile_rows = (static_cast<std::size_t>(m_extents.extent(0)) + TileRows - 1) /
+                             TileRows;
+      return tile_rows * tiles_per_row() * tile_size;
+    }
+
+    template<std::integral I, std::integral J>
+    [[nodiscard]] constexpr //
+      std::size_t
+      operator()(I i, J j) //
+      const noexcept
+    {
+      const auto row = static_cast<std::size_t>(i);
+      const auto col = static_cast<std::size_t>(j);
+      return ((row / TileRows) * tiles_per_row() + col / TileCols) * tile_size +
+             (row % TileRows) * TileCols + col % TileCols;
+    }
+
+    static constexpr bool is_always_exhaustive() noexcept { return false; }
+  };
+};
+
+////////////
+// mdspan //
+////////////
+
+template<typename T, typename Extents, typename Layout = layout_right>
+struct mdspan
+{
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using extents_type = Extents;
+  using layout_type = Layout;
+  using mapping_type = typename Layout::template mapping<Extents>;
+  using index_type = typename Extents::index_type;
+  using size_type = typename Extents::size_type;
+  using rank_type = typename Extents::rank_type;
+  using data_handle_type = T*;
+  using reference = T&;
+
+  data_handle_type m_data = nullptr;
+  mapping_type m_mapping;
+
+  constexpr mdspan() = default;
+
+  constexpr //
+    mdspan(T* data, const mapping_type& mapping) //
+    noexcept
+    : m_data(data)
+    , m_mapping(mapping)
+  {}
+
+  template<std::integral... Ts>
+  constexpr explicit //
+    mdspan(T* data, Ts... extents) //
+    noexcept
+    : m_data(data)
+    , m_mapping(Extents(extents...))
+  {}
+
+  // Views of non-const elements convert to views of const ones
+  template<typename U>
+    requires std::is_same_v<const U, T>
+  constexpr //
+    mdspan(const mdspan<U, Extents, Layout>& other) //
+    noexcept
+    : m_data(other.data_handle())
+    , m_mapping(other.mapping())
+  {}
+
+  [[nodiscard]] static constexpr rank_type rank() noexcept { return Extents::rank(); }
+
+  [[nodiscard]] constexpr T* data_handle() /*************/ const noexcept { return m_data; }
+  [[nodiscard]] constexpr const mapping_type& mapping() const noexcept { return m_mapping; }
+  [[nodiscard]] constexpr const Extents& extents() /*****/ const noexcept
+  {
+    return m_mapping.extents();
+  }
+
+  [[nodiscard]] constexpr //
+    index_type
+    extent(rank_type r) //
+    const noexcept
+  {
+    return extents().extent(r);
+  }
+
+  [[nodiscard]] constexpr //
+    size_type
+    size() //
+    const noexcept
+  {
+    return static_cast<size_type>(extents().product(0, rank()));
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  template<std::integral... Indices>
+    requires(sizeof...(Indices) == Extents::rank())
+  [[nodiscard]] constexpr //
+    reference
+    operator()(Indices... indices) //
+    const noexcept
+  {
+    return m_data[m_mapping(indices...)];
+  }
+};
+
+// Calls op(i, j, ...) for every index of e, in row-major order
+template<typename Extents, typename Op>
+constexpr //
+  void
+  for_each_index(const Extents& e, Op op)
+{
+  std::array<std::size_t, Extents::rank()> index{};
+  for (auto n = e.product(0, Extents::rank()); n > 0; --n) {
+    std::apply(op, index);
+    for (auto r = Extents::rank(); r > 0; --r) {
+      if (++index[r - 1] < static_cast<std::size_t>(e.extent(r - 1))) {
+        break;
+      }
+      index[r - 1] = 0;
+    }
+  }
+}
+
+//////////////////////
+// copy / transpose //
+//////////////////////
+
+// Square blocks of this many elements per side fit a few cache lines per row in L1
+inline constexpr std::size_t md_block = 32;
+
+// Whether the static extents of src and dst, where both have one, allow dst to be src transposed
+template<typename SrcExtents, typename DstExtents>
+[[nodiscard]] constexpr //
+  bool
+  transposable_extents() //
+  noexcept
+{
+  const auto fits = [](std::size_t a, std::size_t b) {
+    return a == dynamic_extent or b == dynamic_extent or a == b;
+  };
+  return fits(SrcExtents::static_extent(0), DstExtents::static_extent(1)) and
+         fits(SrcExtents::static_extent(1), DstExtents::static_extent(0));
+}
+
+template<typename T,
+         typename U,
+         typename SrcExtents,
+         typename DstExtents,
+         typename SrcLayout,
+         typename DstLayout>
+  requires(SrcExtents::rank() == 2 and DstExtents::rank() == 2)
+constexpr //
+  void
+  transpose(mdspan<T, SrcExtents, SrcLayout> src, mdspan<U, DstExtents, DstLayout> dst) //
+  noexcept
+{
+  static_assert(transposable_extents<SrcExtents, DstExtents>(),
+                "The extents of dst must be those of src, swapped.");
+  const auto rows = static_cast<std::size_t>(std::min<std::size_t>(src.extent(0), dst.extent(1)));
+  const auto cols = static_cast<std::size_t>(std::min<std::size_t>(src.extent(1), dst.extent(0)));
+  for (std::size_t i0 = 0; i0 < rows; i0 += md_block) {
+    for (std::size_t j0 = 0; j0 < cols; j0 += md_block) {
+      const auto i1 = std::min(i0 + md_block, rows);
+      const auto j1 = std::min(j0 + md_block, cols);
+      for (auto i = i0; i < i1; ++i) {
+        for (auto j = j0; j < j1; ++j) {
+          dst(j, i) = src(i, j);
+        }
+      }
+    }
+  }
+}
+
+template<typename T, typename U, typename Extents, typename SrcLayout, typename DstLayout>
+constexpr //
+  void
+  copy(mdspan<T, Extents, SrcLayout> src, mdspan<U, Extents, DstLayout> dst) //
+  noexcept
+{
+  if constexpr (std::is_same_v<SrcLayout, DstLayout>) {
+    // Same padding too, so copying it along is cheaper than skipping it
+    if (src.extents() == dst.extents()) {
+      const auto n = src.mapping().required_span_size();
+      std::copy(src.data_handle(), src.data_handle() + n, dst.data_handle());
+      return;
+    }
+  }
+  if constexpr (Extents::rank() == 2) {
+    const auto rows = static_cast<std::size_t>(std::min(src.extent(0), dst.extent(0)));
+    const auto cols = static_cast<std::size_t>(std::min(src.extent(1), dst.extent(1)));
+    for (std::size_t i0 = 0; i0 < rows; i0 += md_block) {
+      for (std::size_t j0 = 0; j0 < cols; j0 += md_block) {
+        const auto i1 = std::min(i0 + md_block, rows);
+        const auto j1 = std::min(j0 + md_block, cols);
+        for (auto i = i0; i < i1; ++i) {
+          for (auto j = j0; j < j1; ++j) {
+            dst(i, j) = src(i, j);
+          }
+        }
+      }
+    }
+  } else {
+    [&]<std::size_t... R>(std::index_sequence<R...>) {
+      for_each_index(src.extents(), [&](auto... i) {
+        if (((i < static_cast<std::size_t>(dst.extent(R))) and ...)) {
+          dst(i...) = src(i...);
+        }
+      });
+    }(std::make_index_sequence<Extents::rank()>());
+  }
+}
+
+} // namespace constexpr_containers
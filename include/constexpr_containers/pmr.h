@@ -0,0 +1,15 @@
+#pragma once
+
+#include <memory_resource> // for polymorphic_allocator
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers::pmr {
+
+// Aliases using std::pmr::polymorphic_allocator, apart from vector.h so that only their users
+// pay for <memory_resource>.
+
+template<typename T>
+using vector = ::constexpr_containers::vector_base<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace constexpr_containers::pmr
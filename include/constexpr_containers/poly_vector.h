@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+#include "constexpr_containers/views.h"
+
+namespace constexpr_containers {
+
+// Contiguous vector of objects of different classes derived from Base, replacing
+// vector<unique_ptr<Base>>: the objects sit back to back in one buffer, each at the alignment of
+// its own type, and are reached through Base& for virtual calls.
+//
+// Synopsis:
+//
+// poly_vector<Base, Allocator>
+//   Buffer of objects plus a table of (object offset, Base offset, type) entries. Growth moves
+//   every object into a buffer twice as large, through std::move_if_noexcept as std::vector
+//   does: if one of them throws, the objects stay where they were
+// emplace_back<Derived>(args...)
+//   Constructs a Derived at the end, returns it
+// operator[](i), begin(), end()
+//   The objects as Base&, in insertion order
+// type(i)
+//   The dynamic type of object i
+// group_by_type()
+//   Stably reorders the objects so that those of the same type are adjacent, in order of first
+//   appearance, which makes the virtual calls of a loop over them predictable
+// for_each_of<Derived>(op)
+//   Calls op(Derived&) on every object of dynamic type Derived, without virtual dispatch
+//
+// Types cannot be aligned beyond std::max_align_t. poly_vector is move-only, and not constexpr.
+
+template<typename Base, typename Allocator = std::allocator<std::byte>>
+struct poly_vector
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  // The unit of storage, aligned for any supported type
+  struct alignas(std::max_align_t) unit
+  {
+    std::byte bytes[alignof(std::max_align_t)];
+  };
+
+  // What poly_vector needs to know about a derived type, one instance per type
+  struct type_ops
+  {
+    const std::type_info* type;
+    std::size_t size;
+    std::size_t alignment;
+    // Constructs dst from std::move_if_noexcept(src)
+    void (*move)(void* src, void* dst);
+    void (*destroy)(void* object);
+  };
+
+  template<typename Derived>
+  static constexpr type_ops ops_of = {
+    &typeid(Derived),
+    sizeof(Derived),
+    alignof(Derived),
+    [](void* src, void* dst) {
+      ::new (dst) Derived(std::move_if_noexcept(*std::launder(static_cast<Derived*>(src))));
+    },
+    [](void* object) { std::launder(static_cast<Derived*>(object))->~Derived(); },
+  };
+
+  struct entry
+  {
+    std::size_t object;
+    // Offset of the Base subobject, which need not be at the start of the object
+    std::size_t base;
+    const type_ops* ops;
+  };
+
+  template<typename U>
+  using rebind = vector_base<U, typename AllocTraitsT::template rebind_alloc<U>>;
+
+  template<bool Const>
+  struct basic_iterator;
+
+public:
+  using value_type = Base;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+  using difference_type = typename AllocTraitsT::difference_type;
+  using reference = Base&;
+  using const_reference = const Base&;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  // Only reserved, as units are implicit-lifetime: objects are constructed in its capacity
+  rebind<unit> m_storage;
+  rebind<entry> m_entries;
+  // Bytes used, up to the end of the last object
+  std::size_t m_used = 0;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  poly_vector() = default;
+
+  explicit //
+    poly_vector(const Allocator& alloc)
+    : m_storage(alloc)
+    , m_entries(alloc)
+  {}
+
+  poly_vector(const poly_vector&) = delete;
+
+  poly_vector(poly_vector&& other) noexcept
+    : m_storage(std::move(other.m_storage))
+    , m_entries(std::move(other.m_entries))
+    , m_used(std::exchange(other.m_used, 0))
+  {}
+
+  poly_vector& operator=(poly_vector&& other) noexcept
+  {
+    poly_vector(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~poly_vector() { clear(); }
+
+  void swap(poly_vector& other) noexcept
+  {
+    std::swap(m_storage, other.m_storage);
+    std::swap(m_entries, other.m_entries);
+    std::swap(m_used, other.m_used);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] size_type size() /*******/ const noexcept { return m_entries.size(); }
+  [[nodiscard]] bool empty() /***********/ const noexcept { return m_entries.empty(); }
+  [[nodiscard]] std::size_t bytes_used() const noexcept { return m_used; }
+
+  [[nodiscard]] std::size_t byte_capacity() const noexcept
+  {
+    return m_storage.capacity() * sizeof(unit);
+  }
+
+  [[nodiscard]] Base& operator[](size_type i) noexcept { return *base(m_entries[i]); }
+  [[nodiscard]] const Base& operator[](size_type i) const noexcept
+  {
+    return *base(m_entries[i]);
+  }
+
+  [[nodiscard]] Base& back() noexcept { return *base(m_entries.back()); }
+  [[nodiscard]] const Base& back() const noexcept { return *base(m_entries.back()); }
+
+  [[nodiscard]] const std::type_info& type(size_type i) const noexcept
+  {
+    return *m_entries[i].ops->type;
+  }
+
+  [[nodiscard]] iterator begin() /**************/ noexcept { return make_iterator(this, 0); }
+  [[nodiscard]] const_iterator begin() /**/ const noexcept { return make_iterator(this, 0); }
+  [[nodiscard]] iterator end() /****************/ noexcept { return make_iterator(this, size()); }
+  [[nodiscard]] const_iterator end() /****/ const noexcept { return make_iterator(this, size()); }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename Derived, typename... Args>
+  Derived& emplace_back(Args&&... args)
+  {
+    static_assert(std::is_base_of_v<Base, Derived>, "Elements must derive from Base.");
+    static_assert(alignof(Derived) <= alignof(std::max_align_t),
+                  "Over-aligned types are not supported.");
+
+    const auto object = align_up(m_used, alignof(Derived));
+    reserve_bytes(object + sizeof(Derived));
+    // So that recording the entry cannot throw once the object exists
+    if (m_entries.size() == m_entries.capacity()) {
+      m_entries.reserve(m_entries.size() * 2 + 1);
+    }
+    auto* derived = ::new (bytes() + object) Derived(std::forward<Args>(args)...);
+    const auto base = reinterpret_cast<std::byte*>(static_cast<Base*>(derived)) - bytes();
+    m_entries.push_back({ object, static_cast<std::size_t>(base), &ops_of<Derived> });
+    m_used = object + sizeof(Derived);
+    return *derived;
+  }
+
+  void pop_back() noexcept
+  {
+    const auto& last = m_entries.back();
+    last.ops->destroy(bytes() + last.object);
+    m_entries.pop_back();
+    m_used = m_entries.empty() ? 0 : end_of(m_entries.back());
+  }
+
+  // Keeps the capacity
+  void clear() noexcept
+  {
+    for (const auto& e : m_entries) {
+      e.ops->destroy(bytes() + e.object);
+    }
+    m_entries.clear();
+    m_used = 0;
+  }
+
+  void reserve_bytes(std::size_t new_cap)
+  {
+    if (new_cap > byte_capacity()) {
+      relocate_into(std::max(new_cap, 2 * byte_capacity() + sizeof(unit)), m_entries);
+    }
+  }
+
+  void group_by_type()
+  {
+    // Types in order of first appearance, then a stable counting sort of the entries by type
+    rebind<const type_ops*> types;
+    rebind<std::size_t> rank(m_entries.size());
+    for (size_type i = 0; i < m_entries.size(); ++i) {
+      const auto it = std::find(types.begin(), types.end(), m_entries[i].ops);
+      rank[i] = static_cast<std::size_t>(it - types.begin());
+      if (it == types.end()) {
+        types.push_back(m_entries[i].ops);
+      }
+    }
+    rebind<std::size_t> start(types.size() + 1);
+    for (const auto r : rank) {
+      ++start[r + 1];
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    rebind<entry> order(m_entries.size());
+    for (size_type i = 0; i < m_entries.size(); ++i) {
+      order[start[rank[i]]++] = m_entries[i];
+    }
+    // Padding changes with the order, so the grouped objects may need more than the capacity
+    relocate_into(std::max(byte_capacity(), packed_size(order)), order);
+  }
+
+  template<typename Derived, typename Op>
+  void for_each_of(Op op)
+  {
+    for (const auto& e : m_entries) {
+      if (e.ops == &ops_of<Derived>) {
+        op(*std::launder(reinterpret_cast<Derived*>(bytes() + e.object)));
+      }
+    }
+  }
+
+private:
+  template<typename Self>
+  [[nodiscard]] static auto make_iterator(Self* self, size_type i) noexcept
+  {
+    basic_iterator<std::is_const_v<Self>> it;
+    it.m_index = static_cast<std::ptrdiff_t>(i);
+    it.m_vector = self;
+    return it;
+  }
+
+  [[nodiscard]] static constexpr std::size_t align_up(std::size_t n, std::size_t a) noexcept
+  {
+    return (n + a - 1) / a * a;
+  }
+
+  [[nodiscard]] static std::size_t end_of(const entry& e) noexcept
+  {
+    return e.object + e.ops->size;
+  }
+
+  [[nodiscard]] std::byte* bytes() noexcept
+  {
+    return reinterpret_cast<std::byte*>(std::to_address(m_storage.data()));
+  }
+  [[nodiscard]] const std::byte* bytes() const noexcept
+  {
+    return reinterpret_cast<const std::byte*>(std::to_address(m_storage.data()));
+  }
+
+  [[nodiscard]] Base* base(const entry& e) noexcept
+  {
+    return std::launder(reinterpret_cast<Base*>(bytes() + e.base));
+  }
+  [[nodiscard]] const Base* base(const entry& e) const noexcept
+  {
+    return std::launder(reinterpret_cast<const Base*>(bytes() + e.base));
+  }
+
+  // Bytes that the objects of order take, packed in that order
+  [[nodiscard]] static std::size_t packed_size(const rebind<entry>& order) noexcept
+  {
+    std::size_t used = 0;
+    for (const auto& e : order) {
+      used = align_up(used, e.ops->alignment) + e.ops->size;
+    }
+    return used;
+  }
+
+  // Moves the objects of order, entries of this vector, into a new buffer of capacity bytes,
+  // packed in that order. The old objects are only destroyed once all of them have moved
+  void relocate_into(std::size_t capacity, const rebind<entry>& order)
+  {
+    rebind<unit> storage(m_storage.get_allocator());
+    storage.reserve((capacity + sizeof(unit) - 1) / sizeof(unit));
+    auto* const dst = reinterpret_cast<std::byte*>(std::to_address(storage.data()));
+    rebind<entry> entries(m_entries.get_allocator());
+    entries.reserve(std::max(order.size(), m_entries.capacity()));
+
+    std::size_t used = 0;
+    try {
+      for (const auto& e : order) {
+        const auto object = align_up(used, e.ops->alignment);
+        e.ops->move(bytes() + e.object, dst + object);
+        entries.push_back({ object, object + (e.base - e.object), e.ops });
+        used = object + e.ops->size;
+      }
+    } catch (...) {
+      for (const auto& e : entries) {
+        e.ops->destroy(dst + e.object);
+      }
+      throw;
+    }
+    for (const auto& e : m_entries) {
+      e.ops->destroy(bytes() + e.object);
+    }
+    std::swap(m_storage, storage);
+    std::swap(m_entries, entries);
+    m_used = used;
+  }
+};
+
+template<typename Base, typename Allocator>
+template<bool Const>
+struct poly_vector<Base, Allocator>::basic_iterator : index_iterator_base<basic_iterator<Const>>
+{
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Base;
+  using reference = std::conditional_t<Const, const Base&, Base&>;
+  using pointer = std::conditional_t<Const, const Base*, Base*>;
+
+  std::conditional_t<Const, const poly_vector, poly_vector>* m_vector = nullptr;
+
+  [[nodiscard]] reference operator*() const noexcept { return (*m_vector)[this->m_index]; }
+  [[nodiscard]] pointer operator->() const noexcept { return &**this; }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Min-priority queues for integer keys that never go below the last key popped, such as
+// Dijkstra distances or timer deadlines. Both keep their elements in vector_base buckets that
+// keep their capacity, so a queue that is reused or refilled stops allocating.
+//
+// Synopsis:
+//
+// radix_heap<Key, Value, Allocator>
+//   Bucket i holds the elements whose key first differs from the last key popped at bit i - 1.
+//   A pop that finds bucket 0 empty redistributes the lowest non-empty bucket into lower ones,
+//   so every element moves at most digits times: pops are amortized O(log C) for keys spread
+//   over C, regardless of the number of elements.
+// bucket_queue<Value, Allocator>
+//   Dial's algorithm: a ring of buckets, one per priority, for priorities that stay within
+//   max_spread of the last one popped. Pushes and pops are amortized O(1).
+//
+// push(key, value), append(first, last)
+//   Adds elements, whose keys must not be less than top_key()
+// top_key(), top()
+//   The smallest key and a value pushed with it. Not const: they move the next elements into
+//   place first. top_key() of an empty queue is the last key popped
+// pop()
+//   Removes top(). top() and pop() require a non-empty queue
+
+////////////////
+// radix_heap //
+////////////////
+
+template<std::unsigned_integral Key,
+         typename Value,
+         typename Allocator = std::allocator<std::pair<Key, Value>>>
+struct radix_heap
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr std::size_t bucket_count = std::numeric_limits<Key>::digits + 1;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  using Bucket = vector_base<value_type, Allocator>;
+  using BucketAllocator = typename AllocTraitsT::template rebind_alloc<Bucket>;
+
+  vector_base<Bucket, BucketAllocator> m_buckets;
+  // Bit i - 1 is set when bucket i > 0 is non-empty
+  std::uint64_t m_nonempty = 0;
+  size_type m_size = 0;
+  Key m_last = 0;
+
+  static_assert(bucket_count <= 65, "Bucket occupancy must fit in a 64-bit mask.");
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr //
+    radix_heap()
+  {
+    m_buckets.resize(bucket_count);
+  }
+
+  template<std::input_iterator InputIt>
+  constexpr //
+    radix_heap(InputIt first, InputIt last)
+    : radix_heap()
+  {
+    append(first, last);
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type size() /**/ const noexcept { return m_size; }
+  [[nodiscard]] constexpr bool empty() /******/ const noexcept { return m_size == 0; }
+
+  [[nodiscard]] constexpr //
+    Key
+    top_key()
+  {
+    settle();
+    return m_last;
+  }
+
+  [[nodiscard]] constexpr //
+    const Value&
+    top()
+  {
+    settle();
+    return m_buckets[0].back().second;
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename... Args>
+  constexpr //
+    void
+    emplace(Key key, Args&&... args)
+  {
+    const auto i = bucket_of(key);
+    m_buckets[i].emplace_back(std::piecewise_construct,
+                              std::forward_as_tuple(key),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+    m_nonempty |= i == 0 ? 0 : std::uint64_t{ 1 } << (i - 1);
+    ++m_size;
+  }
+
+  constexpr void push(Key key, const Value& value) { emplace(key, value); }
+  constexpr void push(Key key, Value&& value) { emplace(key, std::move(value)); }
+
+  // Pushes (key, value) pairs
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      const auto& [key, value] = *first;
+      emplace(key, value);
+    }
+  }
+
+  constexpr //
+    void
+    pop()
+  {
+    settle();
+    m_buckets[0].pop_back();
+    --m_size;
+  }
+
+  // Also resets the minimum key to 0; buckets keep their capacity
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    for (auto& bucket : m_buckets) {
+      bucket.clear();
+    }
+    m_nonempty = 0;
+    m_size = 0;
+    m_last = 0;
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    std::size_t
+    bucket_of(Key key) //
+    const noexcept
+  {
+    return static_cast<std::size_t>(std::bit_width(static_cast<Key>(key ^ m_last)));
+  }
+
+  // Makes bucket 0 non-empty, by redistributing the lowest non-empty bucket around its minimum
+  constexpr //
+    void
+    settle()
+  {
+    if (m_size == 0 or not m_buckets[0].empty()) {
+      return;
+    }
+    const auto i = static_cast<std::size_t>(std::countr_zero(m_nonempty)) + 1;
+    auto& bucket = m_buckets[i];
+    m_last = bucket[0].first;
+    for (const auto& element : bucket) {
+      m_last = element.first < m_last ? element.first : m_last;
+    }
+    // Every key in bucket i now differs from m_last below bit i - 1
+    for (auto& element : bucket) {
+      const auto j = bucket_of(element.first);
+      m_buckets[j].push_back(std::move(element));
+      m_nonempty |= j == 0 ? 0 : std::uint64_t{ 1 } << (j - 1);
+    }
+    bucket.clear();
+    m_nonempty &= ~(std::uint64_t{ 1 } << (i - 1));
+  }
+};
+
+//////////////////
+// bucket_queue //
+//////////////////
+
+template<typename Value, typename Allocator = std::allocator<Value>>
+struct bucket_queue
+{
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+public:
+  using key_type = std::size_t;
+  using mapped_type = Value;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+private:
+  using Bucket = vector_base<Value, Allocator>;
+  using BucketAllocator = typename AllocTraitsT::template rebind_alloc<Bucket>;
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  // A power of two larger than max_spread, so that live priorities never share a bucket
+  vector_base<Bucket, BucketAllocator> m_buckets;
+  size_type m_size = 0;
+  key_type m_current = 0;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  // Priorities pushed must lie in [top_key(), top_key() + max_spread]
+  constexpr explicit //
+    bucket_queue(key_type max_spread)
+  {
+    m_buckets.resize(std::bit_ceil(max_spread + 1));
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type size() /**/ const noexcept { return m_size; }
+  [[nodiscard]] constexpr bool empty() /******/ const noexcept { return m_size == 0; }
+
+  [[nodiscard]] constexpr //
+    key_type
+    max_spread() //
+    const noexcept
+  {
+    return m_buckets.size() - 1;
+  }
+
+  [[nodiscard]] constexpr //
+    key_type
+    top_key() //
+    noexcept
+  {
+    settle();
+    return m_current;
+  }
+
+  [[nodiscard]] constexpr //
+    const Value&
+    top() //
+    noexcept
+  {
+    settle();
+    return m_buckets[slot(m_current)].back();
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  template<typename... Args>
+  constexpr //
+    void
+    emplace(key_type key, Args&&... args)
+  {
+    m_buckets[slot(key)].emplace_back(std::forward<Args>(args)...);
+    ++m_size;
+  }
+
+  constexpr void push(key_type key, const Value& value) { emplace(key, value); }
+  constexpr void push(key_type key, Value&& value) { emplace(key, std::move(value)); }
+
+  // Pushes (key, value) pairs
+  template<std::input_iterator InputIt>
+  constexpr //
+    void
+    append(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      const auto& [key, value] = *first;
+      emplace(key, value);
+    }
+  }
+
+  constexpr //
+    void
+    pop() //
+    noexcept
+  {
+    settle();
+    m_buckets[slot(m_current)].pop_back();
+    --m_size;
+  }
+
+  // Also resets the minimum key to 0; buckets keep their capacity
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    for (auto& bucket : m_buckets) {
+      bucket.clear();
+    }
+    m_size = 0;
+    m_current = 0;
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    std::size_t
+    slot(key_type key) //
+    const noexcept
+  {
+    return key & (m_buckets.size() - 1);
+  }
+
+  constexpr //
+    void
+    settle() //
+    noexcept
+  {
+    if (m_size == 0) {
+      return;
+    }
+    while (m_buckets[slot(m_current)].empty()) {
+      ++m_current;
+    }
+  }
+};
+
+} // namespace constexpr_containers
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace constexpr_containers {
+
+// Iterator pairs as standard ranges, kept apart from algorithm.h as <ranges> is one of the
+// costliest standard headers to parse.
+//
+// Synopsis:
+//
+// make_range( begin, end )
+//   Returns an iterator_range view that you can use with range for loop or other std::range
+//   stuff. It is sized, contiguous (with data()) and borrowed when the iterators allow it
+
+// A view over [begin, end), that is sized, contiguous and borrowed whenever its iterators allow.
+template<std::input_or_output_iterator It, std::sentinel_for<It> Sentinel = It>
+struct iterator_range : std::ranges::view_interface<iterator_range<It, Sentinel>>
+{
+  It m_begin;
+  Sentinel m_end;
+
+  constexpr iterator_range() = default;
+
+  constexpr //
+    iterator_range(It begin, Sentinel end) //
+    noexcept(std::is_nothrow_move_constructible_v<It>and
+               std::is_nothrow_move_constructible_v<Sentinel>)
+    : m_begin(std::move(begin))
+    , m_end(std::move(end))
+  {}
+
+  [[nodiscard]] constexpr It begin() /******/ const noexcept { return m_begin; }
+  [[nodiscard]] constexpr Sentinel end() /**/ const noexcept { return m_end; }
+
+  [[nodiscard]] constexpr //
+    auto
+    size() //
+    const noexcept(noexcept(m_end - m_begin)) //
+    requires std::sized_sentinel_for<Sentinel, It>
+  {
+    return static_cast<std::make_unsigned_t<std::iter_difference_t<It>>>(m_end - m_begin);
+  }
+};
+
+template<std::input_or_output_iterator It, std::sentinel_for<It> Sentinel>
+[[nodiscard]] constexpr //
+  iterator_range<It, Sentinel>
+  make_range(It begin, Sentinel end) //
+  noexcept(std::is_nothrow_move_constructible_v<It>and
+             std::is_nothrow_move_constructible_v<Sentinel>)
+{
+  return iterator_range<It, Sentinel>(std::move(begin), std::move(end));
+}
+
+} // namespace constexpr_containers
+
+// Iterators are held by value, so they never dangle along with the range
+template<typename It, typename Sentinel>
+inline constexpr bool
+  std::ranges::enable_borrowed_range<constexpr_containers::iterator_range<It, Sentinel>> = true;
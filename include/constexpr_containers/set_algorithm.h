@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Set operations over sorted, duplicate-free sequences (such as posting lists), appending their
+// results to a vector_base that is reserved for the worst case up front.
+//
+// Synopsis:
+//
+// gallop(first, last, value)
+//   lower_bound that probes first + 1, first + 3, first + 7, ... before binary searching, so
+//   that it costs O(log d) where d is the distance to the result
+// set_intersection(a, b, out), set_union(a, b, out), set_difference(a, b, out)
+//   Appends a & b, a | b or a - b to out. When one input is more than skew_ratio times longer
+//   than the other, the short one drives the loop and gallops through the long one, copying the
+//   skipped runs in bulk. Otherwise the inputs are merged, and intersections of 4-byte integers
+//   compare blocks of 8 against 8 with AVX2 when it is available at runtime.
+// kway_merge(lists, out), kway_union(lists, out)
+//   Merges any number of sorted lists, keeping or dropping duplicates across lists
+
+// Beyond this length ratio, galloping through the longer input beats merging
+inline constexpr std::size_t skew_ratio = 32;
+
+template<typename T>
+[[nodiscard]] constexpr //
+  const T*
+  gallop(const T* first, const T* last, const T& value) //
+  noexcept
+{
+  std::size_t step = 1;
+  const T* lo = first;
+  while (step <= static_cast<std::size_t>(last - lo) and lo[step - 1] < value) {
+    first = lo + step;
+    step *= 2;
+  }
+  return std::lower_bound(first, std::min(lo + step, last), value);
+}
+
+template<typename T, typename Alloc>
+constexpr //
+  void
+  append_range(vector_base<T, Alloc>& out, const T* first, const T* last)
+{
+  if constexpr (std::is_trivially_copyable_v<T> and std::is_trivially_default_constructible_v<T>) {
+    out.append_uninitialized(static_cast<std::size_t>(last - first), [&](T* dst, std::size_t n) {
+      std::copy(first, last, dst);
+      return n;
+    });
+  } else {
+    for (; first != last; ++first) {
+      out.push_back(*first);
+    }
+  }
+}
+
+//////////////////////
+// set_intersection //
+//////////////////////
+
+#if defined(__AVX2__)
+// Intersects 4-byte integers 8 at a time. Returns how far it got into a and b.
+template<typename T, typename Alloc>
+std::pair<std::size_t, std::size_t>
+intersect_avx2(std::span<const T> a, std::span<const T> b, vector_base<T, Alloc>& out)
+{
+  std::size_t i = 0;
+  std::size_t j = 0;
+  const auto rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  while (i + 8 <= a.size() and j + 8 <= b.size()) {
+    const auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data() + i));
+    auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data() + j));
+    auto eq = _mm256_cmpeq_epi32(va, vb);
+    for (int r = 1; r < 8; ++r) {
+      vb = _mm256_permutevar8x32_epi32(vb, rotate);
+      eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+    }
+    for (auto mask = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(eq))); mask != 0;
+         mask &= mask - 1) {
+      out.push_back(a[i + std::countr_zero(mask)]);
+    }
+    const auto a_max = a[i + 7];
+    const auto b_max = b[j + 7];
+    i += a_max <= b_max ? 8 : 0;
+    j += b_max <= a_max ? 8 : 0;
+  }
+  return { i, j };
+}
+#endif
+
+template<typename T, typename Alloc>
+constexpr //
+  void
+  set_intersection(std::span<const T> a, std::span<const T> b, vector_base<T, Alloc>& out)
+{
+  if (a.size() > b.size()) {
+    std::swap(a, b);
+  }
+  out.reserve(out.size() + a.size());
+
+  if (a.size() * skew_ratio < b.size()) {
+    const T* pos = b.data();
+    const T* const end = b.data() + b.size();
+    for (const auto& value : a) {
+      pos = gallop(pos, end, value);
+      if (pos == end) {
+        return;
+      }
+      if (not(value < *pos)) {
+        out.push_back(value);
+      }
+    }
+    return;
+  }
+
+  std::size_t i = 0;
+  std::size_t j = 0;
+#if defined(__AVX2__)
+  if constexpr (std::is_integral_v<T> and sizeof(T) == 4) {
+    if (not std::is_constant_evaluated()) {
+      std::tie(i, j) = intersect_avx2(a, b, out);
+    }
+  }
+#endif
+  while (i < a.size() and j < b.size()) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      out.push_back(a[i]);
+      ++i;
+      ++j;
+    }
+  }
+}
+
+///////////////
+// set_union //
+///////////////
+
+template<typename T, typename Alloc>
+constexpr //
+  void
+  set_union(std::span<const T> a, std::span<const T> b, vector_base<T, Alloc>& out)
+{
+  if (a.size() > b.size()) {
+    std::swap(a, b);
+  }
+  out.reserve(out.size() + a.size() + b.size());
+
+  if (a.size() * skew_ratio < b.size()) {
+    const T* pos = b.data();
+    const T* const end = b.data() + b.size();
+    for (const auto& value : a) {
+      const T* next = gallop(pos, end, value);
+      append_range(out, pos, next);
+      out.push_back(value);
+      pos = next != end and not(value < *next) ? next + 1 : next;
+    }
+    append_range(out, pos, end);
+    return;
+  }
+
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < a.size() and j < b.size()) {
+    if (a[i] < b[j]) {
+      out.push_back(a[i++]);
+    } else if (b[j] < a[i]) {
+      out.push_back(b[j++]);
+    } else {
+      out.push_back(a[i++]);
+      ++j;
+    }
+  }
+  append_range(out, a.data() + i, a.data() + a.size());
+  append_range(out, b.data() + j, b.data() + b.size());
+}
+
+////////////////////
+// set_difference //
+////////////////////
+
+template<typename T, typename Alloc>
+constexpr //
+  void
+  set_difference(std::span<const T> a, std::span<const T> b, vector_base<T, Alloc>& out)
+{
+  out.reserve(out.size() + a.size());
+  const T* pos_a = a.data();
+  const T* const end_a = a.data() + a.size();
+  const T* pos_b = b.data();
+  const T* const end_b = b.data() + b.size();
+
+  if (b.size() * skew_ratio < a.size()) {
+    // Few removals: copy the runs of a between them
+    for (; pos_b != end_b; ++pos_b) {
+      const T* next = gallop(pos_a, end_a, *pos_b);
+      append_range(out, pos_a, next);
+      pos_a = next != end_a and not(*pos_b < *next) ? next + 1 : next;
+    }
+  } else if (a.size() * skew_ratio < b.size()) {
+    // Few candidates: look each one up
+    for (; pos_a != end_a; ++pos_a) {
+      pos_b = gallop(pos_b, end_b, *pos_a);
+      if (pos_b == end_b or *pos_a < *pos_b) {
+        out.push_back(*pos_a);
+      }
+    }
+  } else {
+    while (pos_a != end_a and pos_b != end_b) {
+      if (*pos_a < *pos_b) {
+        out.push_back(*pos_a++);
+      } else if (*pos_b < *pos_a) {
+        ++pos_b;
+      } else {
+        ++pos_a;
+        ++pos_b;
+      }
+    }
+  }
+  append_range(out, pos_a, end_a);
+}
+
+////////////////
+// kway_merge //
+////////////////
+
+template<bool Unique, typename T, std::size_t Extent, typename Alloc>
+constexpr //
+  void
+  kway_merge_impl(std::span<const std::span<const T>, Extent> lists, vector_base<T, Alloc>& out)
+{
+  struct cursor
+  {
+    const T* pos;
+    const T* end;
+  };
+  // Min-heap on the current element of each non-empty list
+  const auto later = [](const cursor& x, const cursor& y) { return *y.pos < *x.pos; };
+  vector_base<cursor, std::allocator<cursor>> heap;
+  heap.reserve(lists.size());
+  std::size_t total = 0;
+  for (const auto& list : lists) {
+    total += list.size();
+    if (not list.empty()) {
+      heap.push_back(cursor{ list.data(), list.data() + list.size() });
+    }
+  }
+  out.reserve(out.size() + total);
+  std::make_heap(heap.begin(), heap.end(), later);
+
+  const auto first = out.size();
+  while (heap.size() > 1) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    auto& top = heap.back();
+    // Take the whole run that stays below the next smallest head
+    const auto& next = *heap.front().pos;
+    do {
+      if (not Unique or out.size() == first or out.back() < *top.pos) {
+        out.push_back(*top.pos);
+      }
+      ++top.pos;
+    } while (top.pos != top.end and *top.pos < next);
+    if (top.pos == top.end) {
+      heap.pop_back();
+    } else {
+      std::push_heap(heap.begin(), heap.end(), later);
+    }
+  }
+  if (not heap.empty()) {
+    auto& last = heap.front();
+    if (Unique and out.size() != first and not(out.back() < *last.pos)) {
+      ++last.pos;
+    }
+    append_range(out, last.pos, last.end);
+  }
+}
+
+template<typename T, std::size_t Extent, typename Alloc>
+constexpr //
+  void
+  kway_merge(std::span<const std::span<const T>, Extent> lists, vector_base<T, Alloc>& out)
+{
+  kway_merge_impl<false>(lists, out);
+}
+
+template<typename T, std::size_t Extent, typename Alloc>
+constexpr //
+  void
+  kway_union(std::span<const std::span<const T>, Extent> lists, vector_base<T, Alloc>& out)
+{
+  kway_merge_impl<true>(lists, out);
+}
+
+///////////////////////////
+// vector_base overloads //
+///////////////////////////
+
+template<typename T, typename A1, typename A2, typename A3>
+constexpr //
+  void
+  set_intersection(const vector_base<T, A1>& a,
+                   const vector_base<T, A2>& b,
+                   vector_base<T, A3>& out)
+{
+  set_intersection(as_span(a), as_span(b), out);
+}
+
+template<typename T, typename A1, typename A2, typename A3>
+constexpr //
+  void
+  set_union(const vector_base<T, A1>& a, const vector_base<T, A2>& b, vector_base<T, A3>& out)
+{
+  set_union(as_span(a), as_span(b), out);
+}
+
+template<typename T, typename A1, typename A2, typename A3>
+constexpr //
+  void
+  set_difference(const vector_base<T, A1>& a, const vector_base<T, A2>& b, vector_base<T, A3>& out)
+{
+  set_difference(as_span(a), as_span(b), out);
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace constexpr_containers {
+
+// Bulk conversion between a sequence of records (array of structures) and one sequence per field
+// (structure of arrays).
+//
+// Fields are described without reflection, either by listing pointers to members as template
+// arguments, or, when none are listed, by position in a tuple-like record (std::get<I>).
+//
+// Synopsis:
+//
+// to_columns<&R::a, &R::b, ...>(rows, col_a, col_b, ...)
+//   col_a[i] = rows[i].a, col_b[i] = rows[i].b, ...
+// to_columns(rows, col_0, col_1, ...)
+//   col_0[i] = get<0>(rows[i]), col_1[i] = get<1>(rows[i]), ...
+// from_columns<&R::a, &R::b, ...>(rows, col_a, col_b, ...), from_columns(rows, col_0, ...)
+//   The reverse, rows[i].a = col_a[i], ...
+//
+// The span overloads are the kernels, the vector_base overloads resize their outputs to fit.
+// At runtime, records made of exactly 2 or 4 fields of 4 bytes, listed in declaration order, into
+// columns of the same types, are transposed 8 records at a time with AVX2 shuffles; everything
+// else, including constant evaluation and conversions, copies field by field in a single pass over
+// the records.
+
+template<std::size_t I, auto... Fields, typename Record>
+[[nodiscard]] constexpr //
+  decltype(auto)
+  record_field(Record& record) //
+  noexcept
+{
+  if constexpr (sizeof...(Fields) == 0) {
+    using std::get;
+    return get<I>(record);
+  } else {
+    return record.*std::get<I>(std::tuple{ Fields... });
+  }
+}
+
+// Whether every field is a 4-byte lane of the record, in order and without padding
+template<auto... Fields, typename Record, std::size_t... I>
+[[nodiscard]] //
+  bool
+  is_packed_lanes(const Record& record, std::index_sequence<I...>) //
+  noexcept
+{
+  if constexpr (not std::is_trivially_copyable_v<Record> or
+                sizeof(Record) != 4 * sizeof...(I) or
+                ((sizeof(record_field<I, Fields...>(record)) != 4) or ...)) {
+    return false;
+  } else {
+    const auto* base = reinterpret_cast<const char*>(std::addressof(record));
+    return ((reinterpret_cast<const char*>(std::addressof(record_field<I, Fields...>(record))) ==
+             base + 4 * I) and
+            ...);
+  }
+}
+
+// Whether each column has exactly the type of its field, so that lanes can be copied as they are
+template<typename Record, typename Columns, auto... Fields>
+inline constexpr bool columns_match_fields = []<std::size_t... I>(std::index_sequence<I...>) {
+  return (std::is_same_v<
+            std::remove_cvref_t<decltype(record_field<I, Fields...>(std::declval<Record&>()))>,
+            std::remove_cv_t<std::tuple_element_t<I, Columns>>> and
+          ...);
+}(std::make_index_sequence<std::tuple_size_v<Columns>>());
+
+#if defined(__AVX2__)
+// Transposes records [i, i + 8) of N 4-byte lanes into N columns
+template<std::size_t N>
+inline //
+  void
+  split_lanes_8(const void* rows, void* const* columns, std::size_t i) //
+  noexcept
+{
+  const auto* in = static_cast<const __m256i*>(rows);
+  auto store = [&](std::size_t c, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(static_cast<std::uint32_t*>(columns[c]) + i),
+                        v);
+  };
+  if constexpr (N == 2) {
+    const auto even_odd = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const auto a = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(in + 0), even_odd);
+    const auto b = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(in + 1), even_odd);
+    store(0, _mm256_permute2x128_si256(a, b, 0x20));
+    store(1, _mm256_permute2x128_si256(a, b, 0x31));
+  } else {
+    const auto r01 = _mm256_loadu_si256(in + 0);
+    const auto r23 = _mm256_loadu_si256(in + 1);
+    const auto r45 = _mm256_loadu_si256(in + 2);
+    const auto r67 = _mm256_loadu_si256(in + 3);
+    const auto t0 = _mm256_unpacklo_epi32(r01, r23); // a0 a2 b0 b2 | a1 a3 b1 b3
+    const auto t1 = _mm256_unpackhi_epi32(r01, r23); // c0 c2 d0 d2 | c1 c3 d1 d3
+    const auto t2 = _mm256_unpacklo_epi32(r45, r67);
+    const auto t3 = _mm256_unpackhi_epi32(r45, r67);
+    // Each column comes out as records 0 2 4 6 | 1 3 5 7
+    const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    store(0, _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t0, t2), order));
+    store(1, _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t0, t2), order));
+    store(2, _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t1, t3), order));
+    store(3, _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t1, t3), order));
+  }
+}
+
+// The inverse of split_lanes_8
+template<std::size_t N>
+inline //
+  void
+  join_lanes_8(void* rows, const void* const* columns, std::size_t i) //
+  noexcept
+{
+  auto* out = static_cast<__m256i*>(rows);
+  auto load = [&](std::size_t c) {
+    return _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(static_cast<const std::uint32_t*>(columns[c]) + i));
+  };
+  if constexpr (N == 2) {
+    const auto a = load(0);
+    const auto b = load(1);
+    // Interleaving within 128-bit halves yields records 0 1 | 4 5 and 2 3 | 6 7
+    const auto lo = _mm256_unpacklo_epi32(a, b);
+    const auto hi = _mm256_unpackhi_epi32(a, b);
+    _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+  } else {
+    const auto a = load(0);
+    const auto b = load(1);
+    const auto c = load(2);
+    const auto d = load(3);
+    const auto ab_lo = _mm256_unpacklo_epi32(a, b); // a0 b0 a1 b1 | a4 b4 a5 b5
+    const auto ab_hi = _mm256_unpackhi_epi32(a, b); // a2 b2 a3 b3 | a6 b6 a7 b7
+    const auto cd_lo = _mm256_unpacklo_epi32(c, d);
+    const auto cd_hi = _mm256_unpackhi_epi32(c, d);
+    const auto r04 = _mm256_unpacklo_epi64(ab_lo, cd_lo); // record 0 | record 4
+    const auto r15 = _mm256_unpackhi_epi64(ab_lo, cd_lo);
+    const auto r26 = _mm256_unpacklo_epi64(ab_hi, cd_hi);
+    const auto r37 = _mm256_unpackhi_epi64(ab_hi, cd_hi);
+    _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(r04, r15, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(r26, r37, 0x20));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(r04, r15, 0x31));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(r26, r37, 0x31));
+  }
+}
+#endif
+
+////////////////
+// to_columns //
+////////////////
+
+template<auto... Fields, typename Record, typename... Ts>
+constexpr //
+  void
+  to_columns(std::span<const Record> rows, std::span<Ts>... columns)
+{
+  constexpr auto N = sizeof...(Ts);
+  static_assert(sizeof...(Fields) == 0 or sizeof...(Fields) == N, "One column per field.");
+  const auto n = std::min({ rows.size(), columns.size()... });
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  if constexpr ((N == 2 or N == 4) and columns_match_fields<Record, std::tuple<Ts...>, Fields...>) {
+    if (not std::is_constant_evaluated() and n != 0 and
+        is_packed_lanes<Fields...>(rows[0], std::make_index_sequence<N>())) {
+      void* const dst[] = { static_cast<void*>(columns.data())... };
+      for (; i + 8 <= n; i += 8) {
+        split_lanes_8<N>(rows.data() + i, dst, i);
+      }
+    }
+  }
+#endif
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    for (; i < n; ++i) {
+      ((columns[i] = record_field<I, Fields...>(rows[i])), ...);
+    }
+  }(std::make_index_sequence<N>());
+}
+
+template<auto... Fields, typename Record, typename Alloc, typename... Ts, typename... Allocs>
+constexpr //
+  void
+  to_columns(const vector_base<Record, Alloc>& rows, vector_base<Ts, Allocs>&... columns)
+{
+  (columns.resize(rows.size()), ...);
+  to_columns<Fields...>(as_span(rows), as_span(columns)...);
+}
+
+//////////////////
+// from_columns //
+//////////////////
+
+template<auto... Fields, typename Record, typename... Ts>
+constexpr //
+  void
+  from_columns(std::span<Record> rows, std::span<const Ts>... columns)
+{
+  constexpr auto N = sizeof...(Ts);
+  static_assert(sizeof...(Fields) == 0 or sizeof...(Fields) == N, "One column per field.");
+  const auto n = std::min({ rows.size(), columns.size()... });
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  if constexpr ((N == 2 or N == 4) and columns_match_fields<Record, std::tuple<Ts...>, Fields...>) {
+    if (not std::is_constant_evaluated() and n != 0 and
+        is_packed_lanes<Fields...>(rows[0], std::make_index_sequence<N>())) {
+      const void* const src[] = { static_cast<const void*>(columns.data())... };
+      for (; i + 8 <= n; i += 8) {
+        join_lanes_8<N>(rows.data() + i, src, i);
+      }
+    }
+  }
+#endif
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    for (; i < n; ++i) {
+      ((record_field<I, Fields...>(rows[i]) = columns[i]), ...);
+    }
+  }(std::make_index_sequence<N>());
+}
+
+template<auto... Fields, typename Record, typename Alloc, typename... Ts, typename... Allocs>
+constexpr //
+  void
+  from_columns(vector_base<Record, Alloc>& rows, const vector_base<Ts, Allocs>&... columns)
+{
+  rows.resize(std::min({ columns.size()... }));
+  from_columns<Fields...>(as_span(rows), as_span(columns)...);
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#if defined(__linux__) and __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace constexpr_containers {
+
+// A minimal io_uring submission / completion ring, through the raw system calls so that
+// liburing is not needed, for the readers and writers that batch many operations per system call.
+// Kernels can lack or forbid io_uring (older kernels, seccomp filters, io_uring_disabled), so
+// users check uring::available() and fall back to the plain system calls.
+//
+// Synopsis:
+//
+// CONSTEXPR_CONTAINERS_HAS_IO_URING
+//   1 when the headers declare io_uring, in which case uring is defined, 0 otherwise
+// uring(entries)
+//   A ring for up to entries operations in flight. Throws std::system_error when the kernel
+//   refuses to set it up
+// uring::available()
+//   Whether the kernel sets up rings, probed once
+// prepare(opcode, fd, addr, len, offset, user_data)
+//   Queues an operation, with the fields of io_uring_sqe of the same names. Returns false,
+//   queueing nothing, when entries operations are already in flight
+// submit(wait_for)
+//   Hands the queued operations to the kernel, then waits for wait_for completions, or for all
+//   operations in flight if fewer
+// reap(op)
+//   Calls op(user_data, result) for each completion, with result as returned by the matching
+//   system call, or -errno. Returns their number
+//
+// A ring is not thread-safe, and buffers must outlive the completion of their operation.
+
+#if defined(__linux__) and __has_include(<linux/io_uring.h>) and defined(__NR_io_uring_setup)
+#define CONSTEXPR_CONTAINERS_HAS_IO_URING 1
+
+struct uring
+{
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  explicit uring(unsigned entries)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+    }
+    m_entries = params.sq_entries;
+
+    m_sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+      m_sq_bytes = m_cq_bytes = m_sq_bytes > m_cq_bytes ? m_sq_bytes : m_cq_bytes;
+    }
+    m_sq = map(m_sq_bytes, IORING_OFF_SQ_RING);
+    m_cq = single_mmap ? m_sq : map(m_cq_bytes, IORING_OFF_CQ_RING);
+    m_sqes = static_cast<io_uring_sqe*>(
+      map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+
+    m_sq_tail = field(m_sq, params.sq_off.tail);
+    m_sq_mask = *field(m_sq, params.sq_off.ring_mask);
+    m_sq_array = field(m_sq, params.sq_off.array);
+    m_cq_head = field(m_cq, params.cq_off.head);
+    m_cq_tail = field(m_cq, params.cq_off.tail);
+    m_cq_mask = *field(m_cq, params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(m_cq) + params.cq_off.cqes);
+  }
+
+  uring(const uring&) = delete;
+  uring& operator=(const uring&) = delete;
+
+  ~uring() { release(); }
+
+  [[nodiscard]] static //
+    bool
+    available() //
+    noexcept
+  {
+    static const bool result = [] {
+      try {
+        uring probe(1);
+        return true;
+      } catch (const std::system_error&) {
+        return false;
+      }
+    }();
+    return result;
+  }
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] unsigned entries() /****/ const noexcept { return m_entries; }
+  [[nodiscard]] unsigned in_flight() /**/ const noexcept { return m_in_flight; }
+
+  ////////////////
+  // Operations //
+  ////////////////
+
+  [[nodiscard]] //
+    bool
+    prepare(std::uint8_t opcode,
+            int fd,
+            const void* addr,
+            std::uint32_t len,
+            std::uint64_t offset,
+            std::uint64_t user_data) //
+    noexcept
+  {
+    // Keeping in flight operations within the submission queue size also keeps the completion
+    // queue, twice as large, from overflowing
+    if (m_in_flight == m_entries) {
+      return false;
+    }
+    const unsigned tail = *m_sq_tail;
+    const unsigned index = tail & m_sq_mask;
+    auto& sqe = m_sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(addr);
+    sqe.len = len;
+    sqe.off = offset;
+    sqe.user_data = user_data;
+    m_sq_array[index] = index;
+    std::atomic_ref<unsigned>(*m_sq_tail).store(tail + 1, std::memory_order_release);
+    ++m_queued;
+    ++m_in_flight;
+    return true;
+  }
+
+  void submit(unsigned wait_for = 0)
+  {
+    // Waiting for more than is in flight would never return
+    wait_for = wait_for < m_in_flight ? wait_for : m_in_flight;
+    while (m_queued > 0 or wait_for > 0) {
+      const auto flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0U;
+      const auto submitted = ::syscall(
+        __NR_io_uring_enter, m_fd, m_queued, wait_for, flags, nullptr, std::size_t{ 0 });
+      if (submitted < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+      }
+      m_queued -= static_cast<unsigned>(submitted);
+      wait_for = 0;
+    }
+  }
+
+  template<typename Op>
+  unsigned reap(Op op)
+  {
+    unsigned head = *m_cq_head;
+    const unsigned tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+    const unsigned count = tail - head;
+    for (; head != tail; ++head) {
+      const auto& cqe = m_cqes[head & m_cq_mask];
+      const auto user_data = cqe.user_data;
+      const auto result = cqe.res;
+      // Frees the slot before op runs, so that op may queue another operation
+      std::atomic_ref<unsigned>(*m_cq_head).store(head + 1, std::memory_order_release);
+      --m_in_flight;
+      op(user_data, result);
+    }
+    return count;
+  }
+
+private:
+  ///////////////////////
+  // Mapping the rings //
+  ///////////////////////
+
+  void* map(std::size_t bytes, off_t offset)
+  {
+    void* const p =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+    if (p == MAP_FAILED) {
+      const int error = errno;
+      release();
+      throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    return p;
+  }
+
+  static unsigned* field(void* ring, std::uint32_t offset) noexcept
+  {
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+  }
+
+  void release() noexcept
+  {
+    if (m_sqes) {
+      ::munmap(m_sqes, m_entries * sizeof(io_uring_sqe));
+    }
+    if (m_cq and m_cq != m_sq) {
+      ::munmap(m_cq, m_cq_bytes);
+    }
+    if (m_sq) {
+      ::munmap(m_sq, m_sq_bytes);
+    }
+    ::close(m_fd);
+  }
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+  int m_fd = -1;
+  unsigned m_entries = 0;
+  unsigned m_queued = 0;
+  unsigned m_in_flight = 0;
+  std::size_t m_sq_bytes = 0;
+  std::size_t m_cq_bytes = 0;
+  void* m_sq = nullptr;
+  void* m_cq = nullptr;
+  io_uring_sqe* m_sqes = nullptr;
+  unsigned* m_sq_tail = nullptr;
+  unsigned* m_sq_array = nullptr;
+  unsigned m_sq_mask = 0;
+  unsigned* m_cq_head = nullptr;
+  unsigned* m_cq_tail = nullptr;
+  unsigned m_cq_mask = 0;
+  io_uring_cqe* m_cqes = nullptr;
+};
+
+#else
+#define CONSTEXPR_CONTAINERS_HAS_IO_URING 0
+#endif
+
+} // namespace constexpr_containers
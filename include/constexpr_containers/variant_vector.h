@@ -0,0 +1,325 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/exceptions.h"
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Sequence of values of any of Ts..., stored as one vector_base per alternative instead of one
+// std::variant per element: no element is padded to the largest alternative, and each type can
+// be processed in a tight loop over its own contiguous column.
+//
+// Synopsis:
+//
+// basic_variant_vector<Index, Allocator, Ts...>, variant_vector<Ts...>
+//   One column per alternative, plus a packed Index per element holding the alternative in its
+//   top bits and the position in that column in the others. variant_vector uses 32-bit indices
+// emplace_back<T>(args...), push_back(value)
+//   Appends a T, the alternative is the one of that exact type
+// visit(i, f), for_each(f)
+//   f(element) on one element, or on all of them in order, dispatching on the alternative
+// visit_all(f)
+//   f(element) on all elements, column by column: one loop per alternative, no per-element
+//   dispatch. The order is by alternative, then by insertion
+// column<T>()
+//   The elements of type T, in insertion order, as a span
+//
+// Elements can only be removed from the back, as removing from a column shifts the positions
+// of the index entries after it.
+
+template<std::unsigned_integral Index, typename Allocator, typename... Ts>
+struct basic_variant_vector
+{
+  static_assert(sizeof...(Ts) > 0, "variant_vector needs at least one alternative.");
+
+  //////////////////
+  // Member types //
+  //////////////////
+
+private:
+  // Purely to make notation easier
+  using AllocTraitsT = std::allocator_traits<Allocator>;
+
+  template<typename U>
+  using rebind = vector_base<U, typename AllocTraitsT::template rebind_alloc<U>>;
+
+public:
+  using index_type = Index;
+  using allocator_type = Allocator;
+  using size_type = typename AllocTraitsT::size_type;
+
+  static constexpr std::size_t alternative_bits = std::bit_width(sizeof...(Ts) - 1);
+  static constexpr std::size_t position_bits =
+    std::numeric_limits<Index>::digits - alternative_bits;
+  // Elements of any one alternative, which is the limit of the position field
+  static constexpr size_type max_column_size = std::numeric_limits<Index>::max() >>
+                                               alternative_bits;
+
+  // Position of T in Ts...
+  template<typename T>
+  static constexpr std::size_t alternative_of = [] {
+    constexpr bool match[] = { std::is_same_v<T, Ts>... };
+    std::size_t i = 0;
+    while (i < sizeof...(Ts) and not match[i]) {
+      ++i;
+    }
+    return i;
+  }();
+
+  /////////////////
+  // Data layout //
+  /////////////////
+
+private:
+  std::tuple<rebind<Ts>...> m_columns;
+  rebind<Index> m_index;
+
+public:
+  //////////////////
+  // Constructors //
+  //////////////////
+
+  constexpr basic_variant_vector() = default;
+
+  constexpr explicit //
+    basic_variant_vector(const Allocator& alloc)
+    : m_columns(rebind<Ts>(alloc)...)
+    , m_index(alloc)
+  {}
+
+  /////////////
+  // Getters //
+  /////////////
+
+  [[nodiscard]] constexpr size_type size() /**/ const noexcept { return m_index.size(); }
+  [[nodiscard]] constexpr bool empty() /******/ const noexcept { return m_index.empty(); }
+
+  // The alternative of element i
+  [[nodiscard]] constexpr //
+    std::size_t
+    index(size_type i) //
+    const noexcept
+  {
+    if constexpr (alternative_bits == 0) {
+      return 0;
+    } else {
+      return static_cast<std::size_t>(m_index[i] >> position_bits);
+    }
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr //
+    bool
+    holds(size_type i) //
+    const noexcept
+  {
+    return index(i) == alternative_of<T>;
+  }
+
+  // Element i, which must be a T
+  template<typename T>
+  [[nodiscard]] constexpr //
+    T&
+    get(size_type i) //
+    noexcept
+  {
+    return std::get<rebind<T>>(m_columns)[position(i)];
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr //
+    const T&
+    get(size_type i) //
+    const noexcept
+  {
+    return std::get<rebind<T>>(m_columns)[position(i)];
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr //
+    std::span<T>
+    column() //
+    noexcept
+  {
+    return as_span(std::get<rebind<T>>(m_columns));
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr //
+    std::span<const T>
+    column() //
+    const noexcept
+  {
+    return as_span(std::get<rebind<T>>(m_columns));
+  }
+
+  //////////////
+  // Visiting //
+  //////////////
+
+  template<typename F>
+  constexpr //
+    decltype(auto)
+    visit(size_type i, F&& f)
+  {
+    return dispatch(*this, index(i), position(i), f);
+  }
+
+  template<typename F>
+  constexpr //
+    decltype(auto)
+    visit(size_type i, F&& f) //
+    const
+  {
+    return dispatch(*this, index(i), position(i), f);
+  }
+
+  template<typename F>
+  constexpr //
+    void
+    for_each(F&& f)
+  {
+    for (size_type i = 0; i < size(); ++i) {
+      visit(i, f);
+    }
+  }
+
+  template<typename F>
+  constexpr //
+    void
+    for_each(F&& f) //
+    const
+  {
+    for (size_type i = 0; i < size(); ++i) {
+      visit(i, f);
+    }
+  }
+
+  template<typename F>
+  constexpr //
+    void
+    visit_all(F&& f)
+  {
+    std::apply([&](auto&... columns) { (visit_column(columns, f), ...); }, m_columns);
+  }
+
+  template<typename F>
+  constexpr //
+    void
+    visit_all(F&& f) //
+    const
+  {
+    std::apply([&](const auto&... columns) { (visit_column(columns, f), ...); }, m_columns);
+  }
+
+  ///////////////
+  // Modifiers //
+  ///////////////
+
+  constexpr //
+    void
+    reserve(size_type new_cap)
+  {
+    m_index.reserve(new_cap);
+  }
+
+  template<typename T, typename... Args>
+    requires(alternative_of<T> < sizeof...(Ts))
+  constexpr //
+    T&
+    emplace_back(Args&&... args)
+  {
+    auto& column = std::get<rebind<T>>(m_columns);
+    if (column.size() == max_column_size) {
+      throw_length_error("Too many elements of one alternative for the index type.");
+    }
+    // Makes room in the index first, so that a failure leaves both unchanged
+    if (m_index.size() == m_index.capacity()) {
+      m_index.reserve(m_index.size() * 2 + 1);
+    }
+    column.emplace_back(std::forward<Args>(args)...);
+    auto entry = static_cast<Index>(column.size() - 1);
+    if constexpr (alternative_bits != 0) {
+      entry |= static_cast<Index>(Index{ alternative_of<T> } << position_bits);
+    }
+    m_index.push_back(entry);
+    return column.back();
+  }
+
+  template<typename U>
+    requires(alternative_of<std::remove_cvref_t<U>> < sizeof...(Ts))
+  constexpr //
+    void
+    push_back(U&& value)
+  {
+    emplace_back<std::remove_cvref_t<U>>(std::forward<U>(value));
+  }
+
+  constexpr //
+    void
+    pop_back()
+  {
+    visit(size() - 1, [&]<typename T>(T&) { std::get<rebind<T>>(m_columns).pop_back(); });
+    m_index.pop_back();
+  }
+
+  constexpr //
+    void
+    clear() //
+    noexcept
+  {
+    std::apply([](auto&... columns) { (columns.clear(), ...); }, m_columns);
+    m_index.clear();
+  }
+
+private:
+  [[nodiscard]] constexpr //
+    size_type
+    position(size_type i) //
+    const noexcept
+  {
+    return static_cast<size_type>(m_index[i] & max_column_size);
+  }
+
+  // Tests the alternatives in turn; the last one needs no test
+  template<std::size_t I = 0, typename Self, typename F>
+  static constexpr //
+    decltype(auto)
+    dispatch(Self& self, std::size_t alternative, size_type pos, F& f)
+  {
+    if constexpr (I + 1 == sizeof...(Ts)) {
+      return f(std::get<I>(self.m_columns)[pos]);
+    } else {
+      if (alternative == I) {
+        return f(std::get<I>(self.m_columns)[pos]);
+      }
+      return dispatch<I + 1>(self, alternative, pos, f);
+    }
+  }
+
+  template<typename Column, typename F>
+  static constexpr //
+    void
+    visit_column(Column& column, F& f)
+  {
+    for (auto& element : column) {
+      f(element);
+    }
+  }
+};
+
+template<typename... Ts>
+using variant_vector = basic_variant_vector<std::uint32_t, std::allocator<std::byte>, Ts...>;
+
+} // namespace constexpr_containers
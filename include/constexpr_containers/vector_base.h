@@ -2,19 +2,35 @@
 
 #include <algorithm>
 #include <compare>
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <new>
-#include <stdexcept>
+#include <span>
 #include <type_traits>
 #include <utility>
 
-#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/algorithm_base.h"
+#include "constexpr_containers/exceptions.h"
+#include "constexpr_containers/vector_fwd.h"
 
 namespace constexpr_containers {
 
+// Lazily picks the ordering of a container of T, so that T need not be comparable at all
+template<typename T>
+struct comparison_type_of
+{
+  using type = std::weak_ordering;
+};
+
+template<std::three_way_comparable T>
+struct comparison_type_of<T>
+{
+  using type = std::compare_three_way_result_t<T>;
+};
+
 template<typename T, typename Allocator>
 struct vector_base
 {
@@ -39,9 +55,7 @@ public:
   using const_iterator = const_pointer;
   using reverse_iterator = std::reverse_iterator<iterator>;
   using reverse_const_iterator = std::reverse_iterator<const_iterator>;
-  using comparison_type = std::conditional_t<std::three_way_comparable<T>,
-                                             decltype(std::declval<T>() <=> std::declval<T>()),
-                                             std::weak_ordering>;
+  using comparison_type = typename comparison_type_of<T>::type;
 
   /////////////////
   // Data layout //
@@ -80,8 +94,8 @@ public:
     : m_alloc(alloc)
   {
     allocate(count, m_alloc);
-    for (auto& elem : make_range(m_begin, m_realend)) {
-      AllocTraitsT::construct(m_alloc, std::launder(&elem), value);
+    for (auto it = m_begin; it != m_realend; ++it) {
+      AllocTraitsT::construct(m_alloc, std::launder(it), value);
     }
     m_end = m_realend;
   }
@@ -91,8 +105,8 @@ public:
     : m_alloc(alloc)
   {
     allocate(count, m_alloc);
-    for (auto& elem : make_range(m_begin, m_realend)) {
-      AllocTraitsT::construct(m_alloc, std::launder(&elem));
+    for (auto it = m_begin; it != m_realend; ++it) {
+      AllocTraitsT::construct(m_alloc, std::launder(it));
     }
     m_end = m_realend;
   }
@@ -106,8 +120,8 @@ public:
     , m_realend(nullptr)
     , m_alloc(alloc)
   {
-    for (const auto& elem : make_range(first, last)) {
-      push_back(elem);
+    for (; first != last; ++first) {
+      push_back(*first);
     }
   }
 
@@ -195,7 +209,7 @@ public:
           AllocTraitsT::deallocate(m_alloc, tmp, other.size());
           throw;
         }
-        AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+        deallocate();
         m_begin = tmp;
         m_end = m_realend = tmp + other.size();
         return *this;
@@ -356,7 +370,7 @@ private:
   {
     if (n >= size()) {
       // TODO: do fancier formatting when I implement constexpr string (?)
-      throw std::out_of_range("Bounds check failed.");
+      throw_out_of_range("Bounds check failed.");
     }
   }
 
@@ -366,7 +380,7 @@ public:
     at(size_type pos)
   {
     check_range(pos);
-    return *this[pos];
+    return (*this)[pos];
   }
   [[nodiscard]] constexpr //
     const_reference
@@ -374,7 +388,7 @@ public:
     const
   {
     check_range(pos);
-    return *this[pos];
+    return (*this)[pos];
   }
 
   [[nodiscard]] constexpr //
@@ -449,7 +463,7 @@ public:
         m_end = end;
         m_realend = tmp + new_cap;
       } catch (...) {
-        AllocTraitsT::deallocate(tmp);
+        AllocTraitsT::deallocate(m_alloc, tmp, new_cap);
         throw;
       }
     }
@@ -469,7 +483,7 @@ public:
         m_end = end;
         m_realend = tmp + oldsize;
       } catch (...) {
-        AllocTraitsT::deallocate(tmp);
+        AllocTraitsT::deallocate(m_alloc, tmp, oldsize);
         throw;
       }
     }
@@ -491,11 +505,11 @@ public:
         m_end = end;
         m_realend = tmp + count;
       } catch (...) {
-        AllocTraitsT::deallocate(tmp);
+        AllocTraitsT::deallocate(m_alloc, tmp, count);
         throw;
       }
     } else if (count > size()) {
-      while (size() > count) {
+      while (size() < count) {
         emplace_back();
       }
     } else {
@@ -523,11 +537,11 @@ public:
         m_end = end;
         m_realend = tmp + count;
       } catch (...) {
-        AllocTraitsT::deallocate(tmp);
+        AllocTraitsT::deallocate(m_alloc, tmp, count);
         throw;
       }
     } else if (count > size()) {
-      while (size() > count) {
+      while (size() < count) {
         emplace_back(value);
       }
     } else {
@@ -542,9 +556,7 @@ public:
     clear() //
     noexcept
   {
-    while (not empty()) {
-      pop_back();
-    }
+    truncate(m_begin);
   }
 
   /////////////////////////
@@ -560,6 +572,7 @@ public:
     if (m_end < m_realend) {
       AllocTraitsT::construct(m_alloc, std::launder(m_end), std::forward<Args>(args)...);
       ++m_end;
+      return;
     }
 
     // Ensure we've fully prepared a tmp buffer before deallocating m_begin
@@ -577,7 +590,7 @@ public:
       throw;
     }
     // buffer is ready, do the swap
-    AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+    deallocate();
     m_begin = tmp;
     m_end = tmp + oldsize + 1;
     m_realend = tmp + newcap;
@@ -588,6 +601,31 @@ public:
   // Strong exception guarantee
   constexpr void push_back(T&& v) { emplace_back(std::move(v)); }
 
+  // Makes room for count more elements, then appends the first n of [first, first + count), where
+  // n <= count is returned by op(first, count) after writing them. At runtime the new elements are
+  // not value-initialized first, so op can read or decode straight into them. Nothing is appended
+  // if op throws. Grows geometrically like emplace_back, so that appending small batches in a loop
+  // stays linear; callers that know the final size reserve it first
+  template<typename Op>
+  constexpr //
+    size_type
+    append_uninitialized(size_type count, Op op)
+    requires std::is_trivially_copyable_v<T> and std::is_trivially_default_constructible_v<T>
+  {
+    if (count > capacity() - size()) {
+      reserve(std::max(size() + count, 2 * capacity() + 1));
+    }
+    if (std::is_constant_evaluated()) {
+      // Constant evaluation only writes to objects whose lifetime has begun
+      for (auto p = m_end; p < m_end + count; ++p) {
+        AllocTraitsT::construct(m_alloc, p);
+      }
+    }
+    const size_type written = op(std::to_address(m_end), count);
+    m_end += written;
+    return written;
+  }
+
   // Conditionally strong exception guarantee
   // as long as value_type is nothrow assignable and constructible either by move or copy.
   template<typename... Args>
@@ -618,7 +656,7 @@ public:
         throw;
       }
       // buffer is ready, do the swap
-      AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+      deallocate();
       m_begin = tmp;
       m_end = tmp + oldsize + 1;
       m_realend = tmp + newcap;
@@ -675,7 +713,7 @@ public:
         throw;
       }
       // buffer is ready, do the swap
-      AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+      deallocate();
       m_begin = tmp;
       m_end = tmp + oldsize + 1;
       m_realend = tmp + newcap;
@@ -721,7 +759,7 @@ public:
           throw;
         }
         // buffer is ready, do the swap
-        AllocTraitsT::deallocate(m_alloc, m_begin, capacity());
+        deallocate();
         m_begin = tmp;
         m_end = tmp + oldsize + count;
         m_realend = tmp + newcap;
@@ -788,11 +826,52 @@ public:
     iterator
     erase(const_iterator first, const_iterator last)
   {
-    move_if_noexcept_launder(last, m_end, first, m_alloc);
-    for (size_t i = 0; i < last - first; ++i) {
-      pop_back();
-    }
-    return first;
+    auto pos = m_begin + (first - m_begin);
+    truncate(std::move(pos + (last - first), m_end, pos));
+    return pos;
+  }
+
+  ////////////////
+  // Algorithms //
+  ////////////////
+
+  // These use the spare capacity past end() as scratch space, so they never allocate.
+  // Elements must be nothrow movable.
+
+  // Merges the sorted ranges [begin(), middle) and [middle, end()), keeping equal elements in
+  // order. Linear when the spare capacity holds the shorter range, O(n log n) otherwise.
+  template<typename Compare = less>
+  constexpr //
+    void
+    merge_inplace(iterator middle, Compare comp = {})
+  {
+    merge_adaptive(m_begin, middle, m_end, comp, m_end, capacity() - size(), m_alloc);
+  }
+
+  // Sorts, then destroys every element equal to its predecessor in one go.
+  // Returns the number of elements removed.
+  template<typename Compare = less>
+  constexpr //
+    size_type
+    sort_unique(Compare comp = {})
+  {
+    std::sort(m_begin, m_end, comp);
+    auto last = std::unique(
+      m_begin, m_end, [&](const T& a, const T& b) { return not comp(a, b); });
+    auto removed = static_cast<size_type>(m_end - last);
+    truncate(last);
+    return removed;
+  }
+
+  // Moves the elements satisfying pred before the others, keeping the relative order within
+  // both groups. Returns the first element not satisfying pred. Linear when the spare capacity
+  // holds size() elements, O(n log n) otherwise.
+  template<typename Pred>
+  constexpr //
+    iterator
+    stable_partition(Pred pred)
+  {
+    return stable_partition_adaptive(m_begin, m_end, pred, m_end, capacity() - size(), m_alloc);
   }
 
   //////////////////////////
@@ -844,7 +923,7 @@ private:
       m_realend = m_begin + capacity;
     } catch (...) {
       if (capacity > max_size()) {
-        throw std::length_error("Tried to allocate too many elements.");
+        throw_length_error("Tried to allocate too many elements.");
       } else {
         throw;
       }
@@ -859,13 +938,23 @@ private:
       return AllocTraitsT::allocate(alloc, capacity, m_begin);
     } catch (...) {
       if (capacity > max_size()) {
-        throw std::length_error("Tried to allocate too many elements.");
+        throw_length_error("Tried to allocate too many elements.");
       } else {
         throw;
       }
     }
   }
 
+  // Destroys [new_end, end()) in one pass
+  constexpr //
+    void
+    truncate(pointer new_end) //
+    noexcept
+  {
+    destroy(new_end, m_end, m_alloc);
+    m_end = new_end;
+  }
+
   constexpr //
     void
     deallocate() //
@@ -877,6 +966,42 @@ private:
   }
 };
 
+template<typename T, typename Alloc>
+[[nodiscard]] constexpr //
+  std::span<T>
+  as_span(vector_base<T, Alloc>& c) //
+  noexcept
+{
+  return std::span<T>(std::to_address(c.data()), c.size());
+}
+
+template<typename T, typename Alloc>
+[[nodiscard]] constexpr //
+  std::span<const T>
+  as_span(const vector_base<T, Alloc>& c) //
+  noexcept
+{
+  return std::span<const T>(std::to_address(c.data()), c.size());
+}
+
+template<typename T, typename Alloc>
+[[nodiscard]] //
+  std::span<const std::byte>
+  as_bytes(const vector_base<T, Alloc>& c) //
+  noexcept
+{
+  return std::as_bytes(as_span(c));
+}
+
+template<typename T, typename Alloc>
+[[nodiscard]] //
+  std::span<std::byte>
+  as_writable_bytes(vector_base<T, Alloc>& c) //
+  noexcept
+{
+  return std::as_writable_bytes(as_span(c));
+}
+
 template<typename T, typename Alloc, typename U>
 constexpr //
   typename vector_base<T, Alloc>::size_type
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace constexpr_containers {
+
+// Declarations only, for headers that name the containers in their interfaces without needing
+// their definitions, and so without any standard header.
+
+template<typename T, typename Allocator>
+struct vector_base;
+
+} // namespace constexpr_containers
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_containers/vector_base.h"
+
+namespace constexpr_containers {
+
+// Views for processing contiguous ranges in blocks.
+//
+// Synopsis:
+//
+// chunks(range, n), range | chunks(n)
+//   Random access, sized view of consecutive std::spans of n elements (the last may be shorter)
+// chunks_by_bytes(range, bytes), range | chunks_by_bytes(bytes)
+//   Like chunks, with as many elements per chunk as fit in bytes (at least one)
+// strided(range, n), range | strided(n)
+//   Random access, sized view of every n-th element, starting with the first
+// for_each_chunk(range, n, op, threads = 1)
+//   Calls op(span) on every chunk, spreading consecutive groups of chunks over threads
+// parallel_for(threads, op)
+//   Calls op(t) for t in [0, threads), one thread each
+
+template<typename T>
+concept contiguous_borrowed_range = std::ranges::contiguous_range<T> and
+                                    std::ranges::sized_range<T> and std::ranges::borrowed_range<T>;
+
+template<std::ranges::range R>
+using range_element_t = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+
+// Provides the random access operators of an iterator that walks a view by index
+template<typename Derived>
+struct index_iterator_base
+{
+  using difference_type = std::ptrdiff_t;
+
+  difference_type m_index = 0;
+
+  constexpr Derived& self() noexcept { return static_cast<Derived&>(*this); }
+
+  constexpr Derived& operator++() /******************/ noexcept { return ++m_index, self(); }
+  constexpr Derived& operator--() /******************/ noexcept { return --m_index, self(); }
+  constexpr Derived& operator+=(difference_type n) /**/ noexcept { return m_index += n, self(); }
+  constexpr Derived& operator-=(difference_type n) /**/ noexcept { return m_index -= n, self(); }
+
+  constexpr //
+    Derived
+    operator++(int) //
+    noexcept
+  {
+    auto tmp = self();
+    ++m_index;
+    return tmp;
+  }
+  constexpr //
+    Derived
+    operator--(int) //
+    noexcept
+  {
+    auto tmp = self();
+    --m_index;
+    return tmp;
+  }
+
+  [[nodiscard]] constexpr //
+    decltype(auto)
+    operator[](difference_type n) //
+    const noexcept
+  {
+    return *(static_cast<const Derived&>(*this) + n);
+  }
+
+  [[nodiscard]] friend constexpr //
+    Derived
+    operator+(Derived it, difference_type n) //
+    noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    Derived
+    operator+(difference_type n, Derived it) //
+    noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr //
+    Derived
+    operator-(Derived it, difference_type n) //
+    noexcept
+  {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr //
+    difference_type
+    operator-(const Derived& a, const Derived& b) //
+    noexcept
+  {
+    return a.m_index - b.m_index;
+  }
+
+  [[nodiscard]] friend constexpr //
+    bool
+    operator==(const Derived& a, const Derived& b) //
+    noexcept
+  {
+    return a.m_index == b.m_index;
+  }
+  [[nodiscard]] friend constexpr //
+    std::strong_ordering
+    operator<=>(const Derived& a, const Derived& b) //
+    noexcept
+  {
+    return a.m_index <=> b.m_index;
+  }
+};
+
+////////////
+// chunks //
+////////////
+
+template<typename T>
+struct chunk_view : std::ranges::view_interface<chunk_view<T>>
+{
+  struct iterator : index_iterator_base<iterator>
+  {
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::span<T>;
+
+    std::span<T> m_data;
+    std::size_t m_chunk = 1;
+
+    [[nodiscard]] constexpr //
+      std::span<T>
+      operator*() //
+      const noexcept
+    {
+      const auto first = this->m_index * m_chunk;
+      return m_data.subspan(first, std::min(m_chunk, m_data.size() - first));
+    }
+  };
+
+  std::span<T> m_data;
+  std::size_t m_chunk = 1;
+
+  constexpr chunk_view() = default;
+  constexpr chunk_view(std::span<T> data, std::size_t chunk) noexcept
+    : m_data(data)
+    , m_chunk(chunk)
+  {}
+
+  [[nodiscard]] constexpr //
+    std::size_t
+    size() //
+    const noexcept
+  {
+    return (m_data.size() + m_chunk - 1) / m_chunk;
+  }
+  [[nodiscard]] constexpr iterator begin() const noexcept { return make_iterator(0); }
+  [[nodiscard]] constexpr iterator end() /**/ const noexcept { return make_iterator(size()); }
+
+private:
+  [[nodiscard]] constexpr //
+    iterator
+    make_iterator(std::size_t index) //
+    const noexcept
+  {
+    iterator it;
+    it.m_index = static_cast<std::ptrdiff_t>(index);
+    it.m_data = m_data;
+    it.m_chunk = m_chunk;
+    return it;
+  }
+};
+
+/////////////
+// strided //
+/////////////
+
+template<typename T>
+struct strided_view : std::ranges::view_interface<strided_view<T>>
+{
+  struct iterator : index_iterator_base<iterator>
+  {
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+
+    T* m_data = nullptr;
+    std::size_t m_stride = 1;
+
+    [[nodiscard]] constexpr //
+      T&
+      operator*() //
+      const noexcept
+    {
+      return m_data[this->m_index * m_stride];
+    }
+  };
+
+  std::span<T> m_data;
+  std::size_t m_stride = 1;
+
+  constexpr strided_view() = default;
+  constexpr strided_view(std::span<T> data, std::size_t stride) noexcept
+    : m_data(data)
+    , m_stride(stride)
+  {}
+
+  [[nodiscard]] constexpr //
+    std::size_t
+    size() //
+    const noexcept
+  {
+    return (m_data.size() + m_stride - 1) / m_stride;
+  }
+  [[nodiscard]] constexpr iterator begin() const noexcept { return make_iterator(0); }
+  [[nodiscard]] constexpr iterator end() /**/ const noexcept { return make_iterator(size()); }
+
+private:
+  [[nodiscard]] constexpr //
+    iterator
+    make_iterator(std::size_t index) //
+    const noexcept
+  {
+    iterator it;
+    it.m_index = static_cast<std::ptrdiff_t>(index);
+    it.m_data = m_data.data();
+    it.m_stride = m_stride;
+    return it;
+  }
+};
+
+} // namespace constexpr_containers
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<constexpr_containers::chunk_view<T>> =
+  true;
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<constexpr_containers::strided_view<T>> =
+  true;
+
+namespace constexpr_containers {
+
+//////////////
+// Adaptors //
+//////////////
+
+// Lets a partially applied view factory be used on the right hand side of |
+template<typename Function>
+struct view_closure
+{
+  Function m_function;
+
+  template<contiguous_borrowed_range R>
+  [[nodiscard]] friend constexpr //
+    auto
+    operator|(R&& range, const view_closure& closure)
+  {
+    return closure.m_function(std::forward<R>(range));
+  }
+};
+
+template<contiguous_borrowed_range R>
+[[nodiscard]] constexpr //
+  auto
+  chunks(R&& range, std::size_t n) //
+  noexcept
+{
+  return chunk_view<range_element_t<R>>(std::span(range), std::max<std::size_t>(n, 1));
+}
+
+template<contiguous_borrowed_range R>
+[[nodiscard]] constexpr //
+  auto
+  chunks_by_bytes(R&& range, std::size_t bytes) //
+  noexcept
+{
+  return chunks(std::forward<R>(range), bytes / sizeof(range_element_t<R>));
+}
+
+template<contiguous_borrowed_range R>
+[[nodiscard]] constexpr //
+  auto
+  strided(R&& range, std::size_t n) //
+  noexcept
+{
+  return strided_view<range_element_t<R>>(std::span(range), std::max<std::size_t>(n, 1));
+}
+
+[[nodiscard]] constexpr //
+  auto
+  chunks(std::size_t n) //
+  noexcept
+{
+  auto f = [n]<typename R>(R&& range) { return chunks(std::forward<R>(range), n); };
+  return view_closure<decltype(f)>{ f };
+}
+
+[[nodiscard]] constexpr //
+  auto
+  chunks_by_bytes(std::size_t bytes) //
+  noexcept
+{
+  auto f = [bytes]<typename R>(R&& range) {
+    return chunks_by_bytes(std::forward<R>(range), bytes);
+  };
+  return view_closure<decltype(f)>{ f };
+}
+
+[[nodiscard]] constexpr //
+  auto
+  strided(std::size_t n) //
+  noexcept
+{
+  auto f = [n]<typename R>(R&& range) { return strided(std::forward<R>(range), n); };
+  return view_closure<decltype(f)>{ f };
+}
+
+//////////////////
+// parallel_for //
+//////////////////
+
+// Calls op(t) for every t < threads, each on its own thread (op(0) on the calling one), and
+// rethrows the first exception thrown once all of them are done. Runs sequentially in constant
+// evaluation.
+template<typename Op>
+constexpr //
+  void
+  parallel_for(unsigned threads, Op op)
+{
+  if (std::is_constant_evaluated() or threads <= 1) {
+    for (unsigned t = 0; t < threads; ++t) {
+      op(t);
+    }
+    return;
+  }
+
+  vector_base<std::exception_ptr, std::allocator<std::exception_ptr>> errors(threads);
+  {
+    vector_base<std::jthread, std::allocator<std::jthread>> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        try {
+          op(t);
+        } catch (...) {
+          errors[t] = std::current_exception();
+        }
+      });
+    }
+    try {
+      op(0);
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+////////////////////
+// for_each_chunk //
+////////////////////
+
+template<contiguous_borrowed_range R, typename Op>
+constexpr //
+  void
+  for_each_chunk(R&& range, std::size_t n, Op op, unsigned threads = 1)
+{
+  const auto view = chunks(std::forward<R>(range), n);
+  const auto count = view.size();
+  threads = std::max(1u, static_cast<unsigned>(std::min<std::size_t>(threads, count)));
+
+  // Each thread takes a consecutive group of chunks, so neighbouring chunks stay on one core
+  parallel_for(threads, [&](unsigned t) {
+    for (auto i = count * t / threads; i < count * (t + 1) / threads; ++i) {
+      op(view[i]);
+    }
+  });
+}
+
+} // namespace constexpr_containers
@@ -0,0 +1,96 @@
+// Module interface unit exporting the whole library as the module constexpr_containers, for
+// translation units that would rather import it than parse the headers:
+//
+//   #include <new> // GCC 12 cannot see placement new through the import otherwise
+//   import constexpr_containers;
+//
+// The standard headers are included in the global module fragment, so including the library
+// headers inside the export block only exports the library's own declarations. Macros, such as
+// CONSTEXPR_CONTAINERS_HAS_EMBED, are not exported.
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <compare>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) and __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+export module constexpr_containers;
+
+export {
+#include "constexpr_containers/algorithm.h"
+#include "constexpr_containers/algorithm_base.h"
+#include "constexpr_containers/any_vector.h"
+#include "constexpr_containers/archetype_store.h"
+#include "constexpr_containers/async_loader.h"
+#include "constexpr_containers/chunked_column.h"
+#include "constexpr_containers/csr_graph.h"
+#include "constexpr_containers/dary_heap.h"
+#include "constexpr_containers/delta_vector.h"
+#include "constexpr_containers/embed.h"
+#include "constexpr_containers/exceptions.h"
+#include "constexpr_containers/filter.h"
+#include "constexpr_containers/gather.h"
+#include "constexpr_containers/generator.h"
+#include "constexpr_containers/io.h"
+#include "constexpr_containers/mdarray.h"
+#include "constexpr_containers/mdspan.h"
+#include "constexpr_containers/pmr.h"
+#include "constexpr_containers/poly_vector.h"
+#include "constexpr_containers/radix_heap.h"
+#include "constexpr_containers/range.h"
+#include "constexpr_containers/set_algorithm.h"
+#include "constexpr_containers/small_sort.h"
+#include "constexpr_containers/soa.h"
+#include "constexpr_containers/uring.h"
+#include "constexpr_containers/variant_vector.h"
+#include "constexpr_containers/vector.h"
+#include "constexpr_containers/vector_base.h"
+#include "constexpr_containers/vector_fwd.h"
+#include "constexpr_containers/views.h"
+}
@@ -0,0 +1,11 @@
+#include "constexpr_containers/extern_templates.h"
+
+namespace constexpr_containers {
+
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(template, int)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(template, std::uint32_t)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(template, std::uint64_t)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(template, double)
+CONSTEXPR_CONTAINERS_VECTOR_BASE_MEMBERS(template, std::byte)
+
+} // namespace constexpr_containers
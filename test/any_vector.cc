@@ -0,0 +1,121 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/any_vector.h"
+
+namespace cec = constexpr_containers;
+
+static_assert(cec::descriptor_of<int>.size == sizeof(int));
+static_assert(cec::descriptor_of<int>.trivially_relocatable);
+static_assert(not cec::descriptor_of<std::string>.trivially_relocatable);
+static_assert(cec::type_descriptor::of<std::unique_ptr<int>>(true).trivially_relocatable);
+
+// Growth, bulk append, erase and copies of a type with non-trivial moves
+bool
+strings()
+{
+  cec::any_vector<> v(cec::descriptor_of<std::string>);
+  std::vector<std::string> ref;
+  for (int i = 0; i < 100; ++i) {
+    ref.push_back(std::string(30, char('a' + i % 26)) + std::to_string(i));
+    v.emplace_back<std::string>(ref.back());
+  }
+  v.append(ref.data(), 10);
+  ref.insert(ref.end(), ref.begin(), ref.begin() + 10);
+  v.erase(5, 25);
+  ref.erase(ref.begin() + 5, ref.begin() + 25);
+  v.pop_back();
+  ref.pop_back();
+
+  const auto copy = v;
+  const auto view = copy.as_span<std::string>();
+  bool ok = std::vector<std::string>(view.begin(), view.end()) == ref;
+
+  v.resize(200);
+  ok = ok and v.size() == 200 and v.get<std::string>(199).empty() and
+       *static_cast<const std::string*>(v[3]) == ref[3];
+  v.clear();
+  return ok and v.empty() and v.capacity() >= 200;
+}
+
+// A type that is only relocatable by declaration
+bool
+unique_ptrs()
+{
+  static constexpr auto descriptor = cec::type_descriptor::of<std::unique_ptr<int>>(true);
+  cec::any_vector<> v(descriptor);
+  for (int i = 0; i < 50; ++i) {
+    v.emplace_back<std::unique_ptr<int>>(std::make_unique<int>(i));
+  }
+  v.erase(0, 10);
+  int sum = 0;
+  for (const auto& p : std::as_const(v).as_span<std::unique_ptr<int>>()) {
+    sum += *p;
+  }
+  auto moved = std::move(v);
+  return sum == (10 + 49) * 40 / 2 and moved.size() == 40 and v.empty();
+}
+
+// Moves that throw on the third call, after which erase keeps what sits in front of the failure
+struct throwing_move
+{
+  static inline int moves = 0;
+  static inline int alive = 0;
+  int value = 0;
+
+  throwing_move(int v = 0) : value(v) { ++alive; }
+  throwing_move(const throwing_move& other) : value(other.value) { ++alive; }
+  throwing_move(throwing_move&& other) : value(other.value)
+  {
+    if (++moves == 3) {
+      throw std::runtime_error("move");
+    }
+    ++alive;
+  }
+  ~throwing_move() { --alive; }
+};
+
+bool
+erase_throws()
+{
+  {
+    cec::any_vector<> v(cec::descriptor_of<throwing_move>);
+    v.reserve(10);
+    for (int i = 0; i < 10; ++i) {
+      v.emplace_back<throwing_move>(i);
+    }
+    throwing_move::moves = 0;
+    try {
+      v.erase(1, 3);
+      return false;
+    } catch (const std::runtime_error&) {
+    }
+    // Elements 3 and 4 moved into 1 and 2, then moving 5 threw
+    if (v.size() != 3 or throwing_move::alive != 3 or v.get<throwing_move>(2).value != 4) {
+      return false;
+    }
+  }
+  return throwing_move::alive == 0;
+}
+
+bool
+wrong_type()
+{
+  cec::any_vector<> v(cec::descriptor_of<double>);
+  v.resize(3);
+  try {
+    (void)v.get<float>(0);
+  } catch (const std::invalid_argument&) {
+    return v.get<double>(2) == 0;
+  }
+  return false;
+}
+
+int
+main()
+{
+  return strings() and unique_ptrs() and erase_throws() and wrong_type() ? 0 : 1;
+}
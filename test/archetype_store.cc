@@ -0,0 +1,131 @@
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "constexpr_containers/archetype_store.h"
+
+namespace cec = constexpr_containers;
+
+struct position
+{
+  float x, y;
+};
+struct velocity
+{
+  float dx, dy;
+};
+struct health
+{
+  int hp;
+};
+
+using world = cec::archetype_store<position, velocity, health>;
+
+static_assert(world::signature_of<velocity, health> == 6);
+
+constexpr bool
+moves_between_tables()
+{
+  world w;
+  const auto a = w.create(position{ 0, 0 }, velocity{ 1, 2 });
+  const auto b = w.create(position{ 5, 5 });
+  const auto c = w.create(position{ 1, 1 }, velocity{ 3, 4 }, health{ 10 });
+  bool ok = w.size() == 3 and w.table_count() == 3 and w.has<velocity>(a) and
+            not w.has<velocity>(b);
+
+  w.add(b, velocity{ -1, -1 });
+  w.add(a, health{ 7 });
+  w.add(a, health{ 8 });
+  ok = ok and w.signature(a) == 7 and w.get<health>(a).hp == 8 and w.get<velocity>(b).dx == -1;
+
+  w.each<position, velocity>([](position& p, const velocity& v) {
+    p.x += v.dx;
+    p.y += v.dy;
+  });
+  ok = ok and w.get<position>(a).x == 1 and w.get<position>(b).y == 4 and
+       w.get<position>(c).y == 5;
+
+  int total_hp = 0;
+  w.parallel_each<health>(4, [&](const health& h) { total_hp += h.hp; });
+  w.remove<health>(c);
+  w.destroy(a);
+  const auto d = w.create(health{ 1 });
+  std::size_t rows = 0;
+  w.each_chunk<position>([&](std::span<const world::entity_type> entities, std::span<position>) {
+    rows += entities.size();
+  });
+  return ok and total_hp == 18 and d == a and rows == 2 and not w.has<health>(c) and
+         w.get<velocity>(c).dy == 4 and w.alive(b) and w.size() == 3;
+}
+
+static_assert(moves_between_tables());
+
+// Random adds, removes and destroys against a map of what each entity should hold
+bool
+matches_reference()
+{
+  cec::archetype_store<std::uint32_t, std::string, double> w;
+  std::map<std::uint32_t, std::uint32_t> ints;
+  std::map<std::uint32_t, std::string> strings;
+  std::mt19937 rng(2);
+  std::vector<std::uint32_t> live;
+  for (int i = 0; i < 20000; ++i) {
+    const auto r = rng();
+    if (live.empty() or r % 5 == 0) {
+      live.push_back(w.create(std::uint32_t(r)));
+      ints[live.back()] = r;
+      strings.erase(live.back());
+      continue;
+    }
+    const auto e = live[r % live.size()];
+    switch (r % 4) {
+      case 0:
+        w.add(e, std::to_string(r));
+        strings[e] = std::to_string(r);
+        break;
+      case 1:
+        w.remove<std::string>(e);
+        strings.erase(e);
+        break;
+      case 2:
+        w.add(e, double(r));
+        break;
+      default:
+        w.destroy(e);
+        ints.erase(e);
+        strings.erase(e);
+        std::erase(live, e);
+        break;
+    }
+  }
+  bool ok = w.size() == live.size();
+  for (const auto e : live) {
+    ok = ok and w.get<std::uint32_t>(e) == ints[e] and
+         (strings.count(e) ? w.has<std::string>(e) and w.get<std::string>(e) == strings[e] :
+                             not w.has<std::string>(e));
+  }
+  // parallel_each visits the same rows as each, once each
+  std::size_t with_strings = 0;
+  std::uint64_t sum = 0;
+  w.each<std::string, std::uint32_t>([&](const std::string&, std::uint32_t i) {
+    ++with_strings;
+    sum += i;
+  });
+  std::atomic<std::size_t> visited = 0;
+  std::atomic<std::uint64_t> parallel_sum = 0;
+  w.parallel_each<std::string, std::uint32_t>(3, [&](const std::string&, std::uint32_t i) {
+    ++visited;
+    parallel_sum += i;
+  });
+  return ok and with_strings == strings.size() and visited == with_strings and
+         parallel_sum == sum;
+}
+
+int
+main()
+{
+  return matches_reference() ? 0 : 1;
+}
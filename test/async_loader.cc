@@ -0,0 +1,154 @@
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "constexpr_containers/async_loader.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// A file holding first, first + 1, ..., first + n - 1 as uint32_t, opened for reading
+struct test_file
+{
+  char path[40] = "/tmp/constexpr_containers_loader_XXXXXX";
+  int fd;
+
+  test_file(std::uint32_t first, std::uint32_t n)
+    : fd(::mkstemp(path))
+  {
+    cec::vector<std::uint32_t> values;
+    for (std::uint32_t i = 0; i < n; ++i) {
+      values.push_back(first + i);
+    }
+    const auto bytes = static_cast<ssize_t>(n * sizeof(std::uint32_t));
+    if (fd < 0 or ::write(fd, values.data(), n * sizeof(std::uint32_t)) != bytes) {
+      std::abort();
+    }
+  }
+
+  ~test_file()
+  {
+    ::close(fd);
+    std::remove(path);
+  }
+};
+
+bool
+counts_from(const cec::vector<std::uint32_t>& v, std::size_t first, std::uint32_t start)
+{
+  for (std::size_t i = first; i < v.size(); ++i) {
+    if (v[i] != start + (i - first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+loads(cec::io_backend backend)
+{
+  // More files than the ring holds, some large enough to take several reads
+  const std::size_t count = 150;
+  cec::vector<std::unique_ptr<test_file>> files;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    const std::uint32_t n = i % 50 == 0 ? (5 << 20) + i : i * 100;
+    files.push_back(std::make_unique<test_file>(i * 1000000, n));
+  }
+
+  cec::async_loader loader(backend, 4);
+  cec::vector<cec::vector<std::uint32_t>> out(count + 1);
+  out[0].push_back(42);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (loader.enqueue(files[i]->fd, out[i]) != i) {
+      return false;
+    }
+  }
+  // A segment from the middle of a file, enqueued from a completion
+  bool ok = loader.pending() == count;
+  std::size_t completions = 0;
+  ok = ok and loader.wait([&](std::size_t id, std::size_t elements, std::error_code error) {
+    const auto expected = id == count ? 50 : out[id].size() - (id == 0 ? 1 : 0);
+    ok = ok and not error and elements == expected;
+    if (++completions == 1) {
+      loader.enqueue(files[3]->fd, out[count], 4 * 50, 4 * 100);
+    }
+  }) == count + 1;
+  ok = ok and loader.pending() == 0 and out[0][0] == 42 and counts_from(out[0], 1, 0);
+  for (std::size_t i = 1; i < count; ++i) {
+    ok = ok and counts_from(out[i], 0, static_cast<std::uint32_t>(i * 1000000));
+  }
+  ok = ok and out[count].size() == 50 and counts_from(out[count], 0, 3000100);
+  return ok and out[50].size() == (5 << 20) + 50 and out[50].capacity() == out[50].size();
+}
+
+bool
+reports_errors(cec::io_backend backend)
+{
+  test_file file(0, 3);
+  cec::async_loader loader(backend, 2);
+  cec::vector<std::uint32_t> bad;
+  cec::vector<std::uint64_t> wide;
+  cec::vector<std::uint32_t> past_end;
+  loader.enqueue(-1, bad, 8, 0);
+  // 12 bytes left, read as 8-byte elements
+  loader.enqueue(file.fd, wide, 16, 0);
+  loader.enqueue(file.fd, past_end, 8, 100);
+  bool ok = true;
+  loader.wait([&](std::size_t id, std::size_t elements, std::error_code error) {
+    ok = ok and elements == 0;
+    ok = ok and (id != 0 or error == std::errc::bad_file_descriptor);
+    ok = ok and (id != 1 or error == std::errc::io_error);
+    ok = ok and (id != 2 or not error);
+  });
+  ok = ok and bad.empty() and wide.empty() and past_end.empty();
+
+  // Sizes are checked up front
+  int pipe_fds[2];
+  ok = ok and ::pipe(pipe_fds) == 0;
+  bool threw = false;
+  try {
+    loader.enqueue(pipe_fds[0], bad);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  ::close(pipe_fds[0]);
+  ::close(pipe_fds[1]);
+  ok = ok and threw and loader.pending() == 0;
+
+  // Ids start over once everything is reported, through poll() as well as wait()
+  ok = ok and loader.enqueue(file.fd, past_end, 8, 0) == 0;
+  while (loader.pending() > 0) {
+    loader.poll([&](std::size_t id, std::size_t elements, std::error_code error) {
+      ok = ok and id == 0 and elements == 2 and not error;
+    });
+  }
+  return ok and loader.enqueue(file.fd, past_end, 4, 8) == 0 and
+         loader.wait([](std::size_t, std::size_t, std::error_code) {}) == 1 and
+         past_end.size() == 3 and past_end[2] == 2;
+}
+
+int
+main()
+{
+  if (not loads(cec::io_backend::system_calls) or
+      not reports_errors(cec::io_backend::system_calls)) {
+    return 1;
+  }
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  if (cec::uring::available() and
+      (not cec::async_loader().uses_io_uring() or not loads(cec::io_backend::io_uring) or
+       not reports_errors(cec::io_backend::io_uring))) {
+    return 1;
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdint>
+
+#include "constexpr_containers/chunked_column.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool skips_chunks()
+{
+  cec::chunked_column<int, 64> c;
+  for (int i = 0; i < 1000; ++i) {
+    c.push_back(i);
+  }
+  c.push_null();
+  int sum = 0;
+  auto matches = c.scan({ 100, 199 }, [&](auto, int v) { sum += v; });
+  return matches == 100 and sum == 14950 and c.chunk_count() == 16 and
+         c.zone(15).null_count == 1 and c.is_null(1000) and not c.is_null(999) and
+         c.count({ -5, 5 }) == 6;
+}
+
+static_assert(skips_chunks());
+
+int main()
+{
+  cec::chunked_column<double> c;
+  for (int i = 0; i < 100000; ++i) {
+    if (i % 7 == 0) {
+      c.push_null();
+    } else {
+      c.push_back(i * 0.5);
+    }
+  }
+  std::size_t expected = 0;
+  for (int i = 20000; i <= 30000; ++i) {
+    expected += i % 7 != 0;
+  }
+  return c.count({ 10000.0, 15000.0 }) == expected ? 0 : 1;
+}
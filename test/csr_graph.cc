@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/csr_graph.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool small_graph()
+{
+  //  0 -> 1 -> 3
+  //  0 -> 2 -> 3 -> 4
+  const std::pair<std::uint32_t, std::uint32_t> edges[] = {
+    { 2, 3 }, { 0, 1 }, { 3, 4 }, { 0, 2 }, { 1, 3 },
+  };
+  const cec::csr_graph<> graph(edges, 6);
+  bool ok = graph.vertex_count() == 6 and graph.edge_count() == 5 and graph.degree(0) == 2 and
+            graph.neighbors(0)[0] == 1 and graph.neighbors(0)[1] == 2 and graph.degree(5) == 0;
+
+  std::uint32_t depth[6] = { 9, 9, 9, 9, 9, 9 };
+  const auto reached = bfs(graph, std::uint32_t{ 0 }, [&](std::uint32_t v, std::size_t d) {
+    depth[v] = std::uint32_t(d);
+  });
+  return ok and reached == 5 and depth[0] == 0 and depth[1] == 1 and depth[2] == 1 and
+         depth[3] == 2 and depth[4] == 3 and depth[5] == 9;
+}
+
+static_assert(small_graph());
+
+int main()
+{
+  // Large enough for several threads
+  const std::uint32_t vertices = 10000;
+  std::mt19937 rng(1);
+  cec::vector<std::pair<std::uint32_t, std::uint32_t>> edges(1 << 19);
+  for (auto& e : edges) {
+    e = { rng() % vertices, rng() % vertices };
+  }
+
+  const cec::csr_graph<> serial(edges, vertices);
+  const cec::csr_graph<> parallel(edges, vertices, 4);
+  if (not std::ranges::equal(serial.offsets(), parallel.offsets()) or
+      not std::ranges::equal(serial.targets(), parallel.targets())) {
+    return 1;
+  }
+
+  // Against a plain adjacency list, which keeps input order too
+  std::vector<std::vector<std::uint32_t>> adjacency(vertices);
+  for (const auto& [from, to] : edges) {
+    adjacency[from].push_back(to);
+  }
+  for (std::uint32_t v = 0; v < vertices; ++v) {
+    if (not std::ranges::equal(parallel.neighbors(v), adjacency[v])) {
+      return 1;
+    }
+  }
+  return 0;
+}
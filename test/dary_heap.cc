@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "constexpr_containers/dary_heap.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool heap_sorts()
+{
+  const int values[] = { 5, 3, 9, 1, 7, 2, 8, 6, 4, 0 };
+  cec::dary_heap<int, 3> heap(std::begin(values), std::end(values));
+  heap.push(11);
+  heap.replace_top(-1);
+  int expected = 9;
+  while (not heap.empty()) {
+    if (heap.top() != expected--) {
+      return false;
+    }
+    heap.pop();
+  }
+  return expected == -2;
+}
+
+constexpr bool decrease_key()
+{
+  cec::indexed_dary_heap<int, 4, std::greater<int>> heap;
+  const auto a = heap.push(10);
+  const auto b = heap.push(20);
+  const auto c = heap.push(30);
+  heap.update(c, 5);
+  bool ok = heap.top_handle() == c and heap[a] == 10;
+  heap.update(c, 25);
+  heap.erase(a);
+  ok = ok and not heap.contains(a) and heap.top_handle() == b;
+  // a's handle is reused
+  ok = ok and heap.push(1) == a and heap.top() == 1;
+  heap.pop();
+  heap.pop();
+  return ok and heap.size() == 1 and heap.top_handle() == c and heap.top() == 25;
+}
+
+static_assert(heap_sorts());
+static_assert(decrease_key());
+
+template<std::size_t D>
+bool
+matches_priority_queue(std::mt19937& rng)
+{
+  std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> ref;
+  cec::dary_heap<std::uint32_t, D, std::greater<>> heap;
+  for (int i = 0; i < 100000; ++i) {
+    const auto v = rng() % 1000;
+    if (ref.empty() or rng() % 3 != 0) {
+      ref.push(v);
+      heap.push(v);
+    } else if (rng() % 2 == 0) {
+      ref.pop();
+      ref.push(v);
+      heap.replace_top(v);
+    } else {
+      ref.pop();
+      heap.pop();
+    }
+    if (ref.size() != heap.size() or (not ref.empty() and ref.top() != heap.top())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Dijkstra-like workload: random decrease-keys checked against a sorted reference
+bool
+indexed_matches(std::mt19937& rng)
+{
+  std::vector<std::uint32_t> keys(5000);
+  for (auto& k : keys) {
+    k = rng() % 100000;
+  }
+  cec::indexed_dary_heap<std::uint32_t, 8, std::greater<>> heap(keys.begin(), keys.end());
+  std::vector<bool> done(keys.size());
+  for (int i = 0; i < 20000; ++i) {
+    const auto h = rng() % keys.size();
+    if (heap.contains(h)) {
+      keys[h] = std::min<std::uint32_t>(keys[h], rng() % 100000);
+      heap.update(h, keys[h]);
+    }
+  }
+  std::uint32_t last = 0;
+  while (not heap.empty()) {
+    const auto h = heap.top_handle();
+    if (done[h] or heap.top() != keys[h] or heap.top() < last) {
+      return false;
+    }
+    done[h] = true;
+    last = heap.top();
+    heap.pop();
+  }
+  return std::all_of(done.begin(), done.end(), [](bool d) { return d; });
+}
+
+int
+main()
+{
+  std::mt19937 rng(7);
+  if (not matches_priority_queue<2>(rng) or not matches_priority_queue<4>(rng) or
+      not matches_priority_queue<8>(rng) or not indexed_matches(rng)) {
+    return 1;
+  }
+  return 0;
+}
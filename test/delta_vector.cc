@@ -0,0 +1,52 @@
+#include <cstdint>
+
+#include "constexpr_containers/delta_vector.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool round_trips()
+{
+  cec::delta_vector<std::uint32_t> v;
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    v.push_back(i * 3);
+  }
+  cec::vector<std::uint32_t> out;
+  v.decode(out);
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    if (out[i] != i * 3 or v[i] != i * 3) {
+      return false;
+    }
+  }
+  return out.size() == 1000 and v.block_count() == 1000 / v.block_size;
+}
+
+constexpr bool searches()
+{
+  cec::delta_vector<std::uint64_t> v{ 1, 1, 4, 9, 9, 9, 20 };
+  return v.lower_bound(0) == 0 and v.lower_bound(9) == 3 and v.lower_bound(21) == 7 and
+         v.contains(20) and not v.contains(5);
+}
+
+static_assert(round_trips());
+static_assert(searches());
+
+int main()
+{
+  cec::delta_vector<std::uint64_t> v;
+  std::uint64_t value = 0;
+  for (std::uint64_t i = 0; i < 100000; ++i) {
+    value += (i * 2654435761u) % 1000;
+    v.push_back(value);
+  }
+  cec::vector<std::uint64_t> out;
+  v.decode(out);
+  value = 0;
+  for (std::uint64_t i = 0; i < 100000; ++i) {
+    value += (i * 2654435761u) % 1000;
+    if (out[i] != value or v[i] != value or v.lower_bound(value) > i) {
+      return 1;
+    }
+  }
+  return v.memory_usage() * 4 < out.size() * sizeof(std::uint64_t) ? 0 : 2;
+}
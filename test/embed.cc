@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "constexpr_containers/embed.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+constexpr unsigned char si_prefixes_csv[] = {
+#if CONSTEXPR_CONTAINERS_HAS_EMBED
+#embed "data/si_prefixes.csv"
+#else
+#include "test/data/si_prefixes.csv.embed"
+#endif
+};
+
+struct prefix
+{
+  std::array<char, 8> name{};
+  int exponent = 0;
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept
+  {
+    return std::string_view(name.data(), std::find(name.begin(), name.end(), '\0'));
+  }
+};
+
+// Parses "name,exponent" lines after the header line, sorted by name for binary search
+constexpr cec::vector<prefix> parse_prefixes()
+{
+  const auto bytes = cec::embedded_bytes(si_prefixes_csv);
+  cec::vector<prefix> table;
+  auto it = std::find(bytes.begin(), bytes.end(), std::byte{ '\n' }) + 1;
+  while (it != bytes.end()) {
+    prefix p;
+    for (std::size_t i = 0; *it != std::byte{ ',' }; ++it, ++i) {
+      p.name[i] = static_cast<char>(*it);
+    }
+    ++it;
+    const bool negative = *it == std::byte{ '-' };
+    if (negative) {
+      ++it;
+    }
+    for (; *it != std::byte{ '\n' }; ++it) {
+      p.exponent = p.exponent * 10 + (static_cast<int>(*it) - '0');
+    }
+    ++it;
+    p.exponent = negative ? -p.exponent : p.exponent;
+    table.push_back(p);
+  }
+  std::sort(table.begin(), table.end(), [](const prefix& a, const prefix& b) {
+    return a.view() < b.view();
+  });
+  return table;
+}
+
+constexpr auto prefixes = cec::freeze<parse_prefixes>();
+
+constexpr int exponent_of(std::string_view name)
+{
+  const auto it = std::lower_bound(
+    prefixes.begin(), prefixes.end(), name, [](const prefix& p, std::string_view n) {
+      return p.view() < n;
+    });
+  return it != prefixes.end() and it->view() == name ? it->exponent : 0;
+}
+
+static_assert(sizeof(si_prefixes_csv) > 0);
+static_assert(prefixes.size() == 24);
+static_assert(exponent_of("kilo") == 3);
+static_assert(exponent_of("quecto") == -30);
+static_assert(exponent_of("deca") == 1);
+static_assert(exponent_of("unit") == 0);
+
+constexpr bool loads_little_endian()
+{
+  constexpr unsigned char data[] = { 0x78, 0x56, 0x34, 0x12, 0xff };
+  const auto bytes = cec::embedded_bytes(data);
+  return cec::load_le<std::uint32_t>(cec::as_span(bytes), 0) == 0x12345678 and
+         cec::load_le<std::uint16_t>(cec::as_span(bytes), 3) == 0xff12 and
+         cec::load_le<std::uint8_t>(cec::as_span(bytes), 4) == 0xff;
+}
+
+static_assert(loads_little_endian());
+
+constexpr std::array<int, 3> squares = cec::freeze<[] {
+  cec::vector<int> v;
+  for (int i = 1; i <= 3; ++i) {
+    v.push_back(i * i);
+  }
+  return v;
+}>();
+
+static_assert(squares == std::array{ 1, 4, 9 });
+
+int main()
+{
+  // Also usable at runtime, on the same bytes
+  const auto bytes = cec::embedded_bytes(si_prefixes_csv);
+  if (bytes.size() != sizeof(si_prefixes_csv) or bytes.front() != std::byte{ 'n' }) {
+    return 1;
+  }
+  const auto table = parse_prefixes();
+  if (not std::equal(table.begin(), table.end(), prefixes.begin(), prefixes.end(),
+                     [](const prefix& a, const prefix& b) {
+                       return a.view() == b.view() and a.exponent == b.exponent;
+                     })) {
+    return 1;
+  }
+  return 0;
+}
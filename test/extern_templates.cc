@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "constexpr_containers/extern_templates.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Still usable in constant expressions, the declarations only affect the emitted copies
+constexpr bool still_constexpr()
+{
+  cec::vector<int> v{ 1, 2, 3 };
+  v.push_back(4);
+  v.erase(v.begin(), v.begin() + 1);
+  v.resize(5, 7);
+  return v == cec::vector<int>{ 2, 3, 4, 7, 7 };
+}
+
+static_assert(still_constexpr());
+
+template<typename T>
+bool round_trips()
+{
+  cec::vector<T> v(3, T{ 1 });
+  cec::vector<T> w(2);
+  w.reserve(10);
+  w.push_back(T{ 2 });
+  const T three{ 3 };
+  w.push_back(three);
+  w.pop_back();
+  auto copy = w;
+  copy = v;
+  w = std::move(copy);
+  w.resize(4);
+  w.shrink_to_fit();
+  return w.size() == 4 and w[0] == T{ 1 } and w[3] == T{} and v.size() == 3;
+}
+
+int main()
+{
+  // Links against the instantiations in libconstexpr_containers.a
+  if (not round_trips<int>() or not round_trips<std::uint32_t>() or
+      not round_trips<std::uint64_t>() or not round_trips<double>() or
+      not round_trips<std::byte>()) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "constexpr_containers/filter.h"
+
+namespace cec = constexpr_containers;
+
+// Compile-time key set
+constexpr std::uint64_t primes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47 };
+
+template<typename Filter>
+constexpr bool
+finds_primes()
+{
+  const Filter filter(primes);
+  bool ok = true;
+  for (const auto p : primes) {
+    ok = ok and filter.contains(p);
+  }
+  // Round trip through the words
+  const auto copy = Filter::from_words(filter.data());
+  bool out[15] = {};
+  return ok and copy.contains_each(primes, out) == 15 and std::all_of(out, out + 15, [](bool b) {
+           return b;
+         });
+}
+
+static_assert(finds_primes<cec::bloom_filter<>>());
+static_assert(finds_primes<cec::xor_filter<>>());
+static_assert(finds_primes<cec::xor_filter<std::uint16_t>>());
+static_assert(not cec::xor_filter<>().contains(1));
+
+// Empty filters, and their round trips through data(), contain nothing
+template<typename Filter>
+constexpr bool
+empty_round_trips()
+{
+  const Filter empty;
+  const auto copy = Filter::from_words(empty.data());
+  return not empty.contains(42) and not copy.contains(42) and copy.data().empty();
+}
+
+static_assert(empty_round_trips<cec::bloom_filter<>>());
+static_assert(empty_round_trips<cec::xor_filter<>>());
+
+// A default-constructed bloom filter allocates a block on the first insert
+constexpr bool
+inserts_into_empty()
+{
+  cec::bloom_filter<> filter;
+  filter.insert(42);
+  return filter.contains(42) and filter.block_count() == 1;
+}
+
+static_assert(inserts_into_empty());
+
+// No false negatives, and a false positive rate near the expected one
+template<typename Filter>
+bool
+rates(double max_false_positives)
+{
+  std::mt19937_64 rng(5);
+  std::vector<std::uint64_t> keys(100000);
+  for (auto& k : keys) {
+    k = rng();
+  }
+  // Duplicates must not break construction
+  keys.insert(keys.end(), keys.begin(), keys.begin() + 1000);
+  const Filter filter(keys);
+
+  std::vector<std::uint64_t> absent(100000);
+  for (auto& k : absent) {
+    k = rng();
+  }
+  const auto bools = std::make_unique<bool[]>(keys.size());
+  if (filter.contains_each(keys, std::span(bools.get(), keys.size())) != keys.size()) {
+    return false;
+  }
+  const auto positives = filter.contains_each(absent, std::span(bools.get(), absent.size()));
+  const auto restored = Filter::from_words(filter.data());
+  return positives < max_false_positives * double(absent.size()) and
+         std::all_of(absent.begin(), absent.begin() + 1000, [&](std::uint64_t k) {
+           return restored.contains(k) == filter.contains(k);
+         });
+}
+
+int
+main()
+{
+  cec::bloom_filter<> growing(std::size_t{ 1000 });
+  growing.insert(42);
+  if (not growing.contains(42) or growing.block_count() != 20) {
+    return 1;
+  }
+  // Also through the vectorized and prefetching paths
+  bool out[20];
+  const std::uint64_t queries[20] = {};
+  if (not empty_round_trips<cec::bloom_filter<>>() or
+      not empty_round_trips<cec::xor_filter<>>() or not inserts_into_empty() or
+      cec::bloom_filter<>().contains_each(queries, out) != 0) {
+    return 1;
+  }
+  return rates<cec::bloom_filter<>>(0.015) and rates<cec::xor_filter<>>(0.006) and
+             rates<cec::xor_filter<std::uint16_t>>(0.0002) ?
+           0 :
+           1;
+}
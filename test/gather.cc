@@ -0,0 +1,68 @@
+#include <cstdint>
+
+#include "constexpr_containers/gather.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool permutes()
+{
+  cec::vector<int> in{ 10, 11, 12, 13, 14 };
+  cec::vector<std::uint32_t> perm{ 3, 0, 4, 1, 2 };
+  cec::vector<int> gathered;
+  cec::gather(in, perm, gathered);
+  cec::vector<int> scattered(5);
+  cec::scatter(gathered, perm, scattered);
+  cec::apply_permutation(in, perm);
+  return gathered == cec::vector<int>{ 13, 10, 14, 11, 12 } and in == gathered and
+         scattered == cec::vector<int>{ 10, 11, 12, 13, 14 };
+}
+
+static_assert(permutes());
+
+// Scattering into a vector too small for the indices grows it, keeping what it held
+constexpr bool scatter_grows()
+{
+  cec::vector<int> in{ 1, 2, 3 };
+  cec::vector<std::uint32_t> indices{ 4, 0, 6 };
+  cec::vector<int> out{ 9, 8 };
+  cec::vector<int> blocked;
+  cec::scatter(in, indices, out);
+  cec::scatter_blocked(in, indices, blocked);
+  return out == cec::vector<int>{ 2, 8, 0, 0, 1, 0, 3 } and
+         blocked == cec::vector<int>{ 2, 0, 0, 0, 1, 0, 3 };
+}
+
+static_assert(scatter_grows());
+
+template<typename T, typename Index>
+bool round_trips(std::size_t n, std::size_t block_bytes)
+{
+  cec::vector<T> in(n);
+  cec::vector<Index> perm(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    in[i] = static_cast<T>(i * 7);
+    perm[i] = static_cast<Index>((i * 48271) % n);
+  }
+  cec::vector<T> gathered, blocked, permuted = in;
+  cec::gather(in, perm, gathered);
+  cec::gather_blocked(in, perm, blocked, block_bytes);
+  cec::apply_permutation(permuted, perm);
+  cec::vector<T> scattered(n), scattered_blocked(n);
+  cec::scatter(gathered, perm, scattered);
+  cec::scatter_blocked(blocked, perm, scattered_blocked, block_bytes);
+  return gathered == blocked and gathered == permuted and scattered == in and
+         scattered_blocked == in;
+}
+
+int main()
+{
+  // 48271 is prime, so i * 48271 % n permutes [0, n) for these n
+  const std::size_t n = 1 << 20;
+  bool ok = round_trips<std::uint32_t, std::uint32_t>(n, 4096) and
+            round_trips<std::uint64_t, std::uint32_t>(n, 4096) and
+            round_trips<float, std::uint64_t>(n, 4096) and
+            round_trips<double, std::int64_t>(n, 4096) and
+            round_trips<std::uint16_t, std::uint32_t>(1000, 64) and scatter_grows();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "constexpr_containers/generator.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+static_assert(std::input_iterator<cec::generator<int>::iterator>);
+static_assert(std::sentinel_for<std::default_sentinel_t, cec::generator<int>::iterator>);
+
+cec::generator<int>
+count(int n, bool hint)
+{
+  if (hint) {
+    co_yield cec::size_hint{ static_cast<std::size_t>(n) };
+  }
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+cec::generator<int>
+count_then_throw(int n)
+{
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+  throw std::runtime_error("generator");
+}
+
+cec::generator<std::string>
+words(int n)
+{
+  for (int i = 0; i < n; ++i) {
+    co_yield std::string(20, static_cast<char>('a' + i % 26));
+  }
+}
+
+cec::batch_generator<int>
+count_in_batches(int n, int batch)
+{
+  co_yield cec::size_hint{ static_cast<std::size_t>(n) };
+  cec::vector<int> buffer;
+  for (int i = 0; i < n;) {
+    buffer.clear();
+    for (; i < n and static_cast<int>(buffer.size()) < batch; ++i) {
+      buffer.push_back(i);
+    }
+    co_yield std::span<const int>(buffer.data(), buffer.size());
+  }
+}
+
+bool
+counts_from(const cec::vector<int>& v, std::size_t first)
+{
+  for (std::size_t i = first; i < v.size(); ++i) {
+    if (v[i] != static_cast<int>(i - first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+iterates()
+{
+  int expected = 0;
+  for (const int i : count(100, false)) {
+    if (i != expected++) {
+      return false;
+    }
+  }
+  auto empty = count(0, true);
+  bool ok = expected == 100 and empty.begin() == empty.end() and empty.hinted_size() == 0;
+
+  // Without a coroutine, as constructed or moved from
+  cec::generator<int> none;
+  auto hinted = count(10, true);
+  auto moved = std::move(hinted);
+  ok = ok and none.begin() == none.end() and none.hinted_size() == 0;
+  ok = ok and hinted.begin() == hinted.end() and moved.begin() != moved.end();
+  cec::vector<int> sink;
+  return ok and moved.hinted_size() == 10 and cec::collect_into(std::move(none), sink) == 0 and
+         sink.empty();
+}
+
+bool
+collects()
+{
+  // Without a hint, across several batches, after existing elements
+  cec::vector<int> v{ -1, -2 };
+  bool ok = cec::collect_into(count(1000, false), v) == 1000;
+  ok = ok and v.size() == 1002 and v[0] == -1 and v[1] == -2 and counts_from(v, 2);
+
+  // The hint reserves exactly once
+  cec::vector<int> hinted;
+  ok = ok and cec::collect_into(count(1000, true), hinted) == 1000;
+  ok = ok and hinted.capacity() == 1000 and counts_from(hinted, 0);
+
+  cec::vector<std::string> strings{ "first" };
+  ok = ok and cec::collect_into(words(100), strings) == 100 and strings.size() == 101;
+  ok = ok and strings[0] == "first" and strings[100] == std::string(20, 'a' + 99 % 26);
+
+  cec::vector<int> batched{ -1 };
+  ok = ok and cec::collect_into(count_in_batches(1000, 64), batched) == 1000;
+  ok = ok and batched.size() == 1001 and batched.capacity() == 1001 and counts_from(batched, 1);
+  return ok;
+}
+
+bool
+rolls_back()
+{
+  cec::vector<int> v{ 7 };
+  bool threw = false;
+  try {
+    cec::collect_into(count_then_throw(500), v);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  return threw and v.size() == 1 and v[0] == 7;
+}
+
+int
+main()
+{
+  return iterates() and collects() and rolls_back() ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "constexpr_containers/io.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+// Writes 0, 1, ..., n - 1 as uint32_t to a new temporary file, and returns its path
+std::string
+make_file(std::uint32_t n)
+{
+  char path[] = "/tmp/constexpr_containers_io_XXXXXX";
+  const int fd = ::mkstemp(path);
+  cec::vector<std::uint32_t> values;
+  for (std::uint32_t i = 0; i < n; ++i) {
+    values.push_back(i);
+  }
+  const auto bytes = static_cast<ssize_t>(values.size() * sizeof(std::uint32_t));
+  if (fd < 0 or ::write(fd, values.data(), values.size() * sizeof(std::uint32_t)) != bytes) {
+    std::abort();
+  }
+  ::close(fd);
+  return path;
+}
+
+bool
+counts_from(const cec::vector<std::uint32_t>& v, std::size_t first, std::uint32_t start)
+{
+  for (std::size_t i = first; i < v.size(); ++i) {
+    if (v[i] != start + (i - first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+reads_fds(const std::string& path, std::uint32_t n)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  cec::vector<std::uint32_t> v{ 7 };
+  // Whole file, reserved at once, after existing elements
+  bool ok = cec::read_into(fd, v) == n and v.size() == n + 1 and v.capacity() == n + 1 and
+            v[0] == 7 and counts_from(v, 1, 0);
+  // At end of file
+  ok = ok and cec::read_into(fd, v) == 0 and v.size() == n + 1;
+
+  // A prefix, then the rest, from the advanced offset
+  ::lseek(fd, 0, SEEK_SET);
+  cec::vector<std::uint32_t> w;
+  ok = ok and cec::read_into(fd, w, 40) == 10 and cec::read_into(fd, w) == n - 10 and
+       counts_from(w, 0, 0) and w.size() == n;
+
+  // pread leaves the offset alone
+  ::lseek(fd, 0, SEEK_SET);
+  cec::vector<std::uint32_t> x;
+  ok = ok and cec::read_into(fd, x, 4 * 100, 4 * 1000) == 100 and counts_from(x, 0, 1000) and
+       ::lseek(fd, 0, SEEK_CUR) == 0;
+  ok = ok and cec::read_into(fd, x, cec::all_bytes, off_t{ 4 } * (n - 5)) == 5 and
+       x.size() == 105 and x[100] == n - 5;
+
+  bool threw = false;
+  try {
+    cec::read_into(fd, x, 6);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  ok = ok and threw and x.size() == 105;
+
+  // A file ending inside an element appends nothing
+  cec::vector<std::uint64_t> wide;
+  threw = false;
+  try {
+    cec::read_into(fd, wide, cec::all_bytes, off_t{ 4 });
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ok = ok and threw and wide.empty();
+  ::close(fd);
+
+  threw = false;
+  try {
+    cec::read_into(fd, x);
+  } catch (const std::system_error&) {
+    threw = true;
+  }
+  return ok and threw and x.size() == 105;
+}
+
+// Pipes have no size, so capacity grows as data arrives
+bool
+reads_pipes()
+{
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    return false;
+  }
+  const char text[] = "streamed through a pipe";
+  const auto bytes = static_cast<ssize_t>(sizeof(text) - 1);
+  const bool written = ::write(fds[1], text, sizeof(text) - 1) == bytes;
+  ::close(fds[1]);
+  cec::vector<char> v;
+  const auto read = cec::read_into(fds[0], v);
+  ::close(fds[0]);
+  return written and read == sizeof(text) - 1 and std::string(v.begin(), v.end()) == text;
+}
+
+// Files of procfs report a size of 0, so only reading to the end finds their contents
+bool
+reads_procfs()
+{
+  const int fd = ::open("/proc/self/status", O_RDONLY);
+  if (fd < 0) {
+    return true;
+  }
+  cec::vector<char> v;
+  cec::vector<char> w;
+  const bool ok = cec::read_into(fd, v) > 0 and cec::read_into(fd, w, cec::all_bytes, 0) > 0;
+  ::close(fd);
+  return ok and std::string(v.begin(), v.begin() + 5) == "Name:" and
+         std::string(w.begin(), w.begin() + 5) == "Name:";
+}
+
+bool
+reads_streams(const std::string& path, std::uint32_t n)
+{
+  std::ifstream file(path, std::ios::binary);
+  cec::vector<std::uint32_t> v;
+  bool ok = cec::append_from(file, v, 4 * 3) == 3 and not file.eof();
+  ok = ok and cec::append_from(file, v) == n - 3 and file.eof() and v.size() == n and
+       counts_from(v, 0, 0);
+
+  std::istringstream text("line one\nline two\n");
+  std::string first;
+  std::getline(text, first);
+  cec::vector<char> rest;
+  ok = ok and cec::append_from(text, rest) == 9 and std::string(rest.begin(), rest.end()) ==
+                                                      "line two\n";
+
+  std::istringstream odd("12345");
+  cec::vector<std::uint32_t> w;
+  bool threw = false;
+  try {
+    cec::append_from(odd, w);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  return ok and threw and w.empty();
+}
+
+// More spans than a single gathering write takes, a fifth of them empty
+bool
+writes(cec::io_backend backend, bool at_file_offset)
+{
+  char path[] = "/tmp/constexpr_containers_io_XXXXXX";
+  const int fd = ::mkstemp(path);
+  cec::vector<cec::vector<std::uint32_t>> parts;
+  cec::vector<std::uint32_t> expected;
+  for (std::uint32_t i = 0; i < 3000; ++i) {
+    cec::vector<std::uint32_t> part;
+    for (std::uint32_t j = 0; j < i % 5; ++j) {
+      part.push_back(i * 10 + j);
+      expected.push_back(i * 10 + j);
+    }
+    parts.push_back(std::move(part));
+  }
+  const std::uint32_t header = 0xC0FFEE;
+
+  cec::vectored_writer writer(fd, at_file_offset ? -1 : 4, backend);
+  if (at_file_offset) {
+    writer.add(std::as_bytes(std::span(&header, 1)));
+  } else {
+    static_cast<void>(::pwrite(fd, &header, sizeof(header), 0));
+  }
+  for (const auto& part : parts) {
+    writer.add(part);
+  }
+  const auto bytes = expected.size() * sizeof(std::uint32_t) + (at_file_offset ? 4 : 0);
+  bool ok = writer.pending() == bytes and writer.flush() == bytes and writer.pending() == 0;
+  ok = ok and writer.offset() == (at_file_offset ? -1 : static_cast<off_t>(4 + bytes));
+  // Flushing again writes nothing
+  ok = ok and writer.flush() == 0;
+
+  cec::vector<std::uint32_t> back;
+  ok = ok and cec::read_into(fd, back, cec::all_bytes, 0) == expected.size() + 1;
+  ok = ok and back[0] == header and std::equal(expected.begin(), expected.end(), back.begin() + 1);
+  ::close(fd);
+  std::remove(path);
+  return ok;
+}
+
+// A file size limit cuts the first write short and fails the others, with all of them in flight.
+// The flush throws once they complete, and the next one starts afresh
+bool
+ring_write_fails()
+{
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  if (not cec::uring::available()) {
+    return true;
+  }
+  char path[] = "/tmp/constexpr_containers_io_XXXXXX";
+  const int fd = ::mkstemp(path);
+  cec::vector<std::uint32_t> data(3 * cec::max_iovecs * 4);
+  for (std::uint32_t i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+  cec::vectored_writer writer(fd, 0, cec::io_backend::io_uring);
+  for (std::size_t i = 0; i < data.size(); i += 4) {
+    writer.add(std::as_bytes(std::span(data.data() + i, 4)));
+  }
+
+  rlimit old_limit;
+  ::getrlimit(RLIMIT_FSIZE, &old_limit);
+  rlimit limit = old_limit;
+  limit.rlim_cur = 1000;
+  const auto old_handler = ::signal(SIGXFSZ, SIG_IGN);
+  ::setrlimit(RLIMIT_FSIZE, &limit);
+  bool threw = false;
+  try {
+    writer.flush();
+  } catch (const std::system_error&) {
+    threw = true;
+  }
+  ::setrlimit(RLIMIT_FSIZE, &old_limit);
+  ::signal(SIGXFSZ, old_handler);
+
+  bool ok = threw and writer.pending() == 0 and writer.offset() == 0 and writer.uses_io_uring();
+  writer.add(std::as_bytes(std::span(data.data(), 1)));
+  ok = ok and writer.flush() == 4 and writer.offset() == 4;
+  cec::vector<std::uint32_t> back;
+  ok = ok and cec::read_into(fd, back, cec::all_bytes, 0) == 250 and back[0] == 0 and
+       back[249] == 249;
+  ::close(fd);
+  std::remove(path);
+  return ok;
+#else
+  return true;
+#endif
+}
+
+bool
+writes_with_each_backend()
+{
+  bool ok = writes(cec::io_backend::system_calls, false) and
+            writes(cec::io_backend::system_calls, true) and
+            writes(cec::io_backend::automatic, false) and writes(cec::io_backend::automatic, true);
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  if (cec::uring::available()) {
+    ok = ok and cec::vectored_writer(0, 0).uses_io_uring() and
+         writes(cec::io_backend::io_uring, false);
+  }
+#endif
+  bool threw = false;
+  try {
+    cec::vectored_writer(0, -1, cec::io_backend::io_uring);
+  } catch (const std::system_error&) {
+    threw = true;
+  }
+  const cec::vectored_writer plain(0, 0, cec::io_backend::system_calls);
+  return ok and threw and not plain.uses_io_uring();
+}
+
+int
+main()
+{
+  const std::uint32_t n = 3 << 20;
+  const auto path = make_file(n);
+  const bool ok = reads_fds(path, n) and reads_pipes() and reads_procfs() and
+                  reads_streams(path, n) and writes_with_each_backend() and
+                  ring_write_fails();
+  std::remove(path.c_str());
+  return ok ? 0 : 1;
+}
@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <iterator>
+#include <ranges>
+#include <string>
+#include <vector>
 
 #include "constexpr_containers/algorithm.h"
 #include "constexpr_containers/vector.h"
@@ -31,9 +35,109 @@ constexpr auto h()
   return 1;
 }
 
+using int_range = decltype(constexpr_containers::make_range(std::declval<int*>(),
+                                                            std::declval<int*>()));
+static_assert(std::ranges::view<int_range>);
+static_assert(std::ranges::contiguous_range<int_range>);
+static_assert(std::ranges::sized_range<int_range>);
+static_assert(std::ranges::borrowed_range<int_range>);
+
+constexpr auto g()
+{
+  constexpr_containers::vector<int> v{ 1, 2, 3 };
+  auto r = constexpr_containers::make_range(v.begin() + 1, v.end());
+  auto s = constexpr_containers::as_span(v);
+  return r.size() + (r.data() == v.data() + 1) + s.size();
+}
+
+// Runs with and without spare capacity, which picks the buffered and the rotating algorithms
+constexpr bool inplace(bool spare)
+{
+  constexpr_containers::vector<int> v{ 1, 4, 4, 9, 2, 4, 8 };
+  if (spare) {
+    v.reserve(32);
+  }
+  v.merge_inplace(v.begin() + 4);
+  bool ok = v == constexpr_containers::vector<int>{ 1, 2, 4, 4, 4, 8, 9 };
+
+  ok = ok and v.sort_unique() == 2 and v == constexpr_containers::vector<int>{ 1, 2, 4, 8, 9 };
+
+  auto mid = v.stable_partition([](int x) { return x % 2 == 1; });
+  ok = ok and mid == v.begin() + 2 and v == constexpr_containers::vector<int>{ 1, 9, 2, 4, 8 };
+  ok = ok and erase_if(v, [](int x) { return x > 4; }) == 2;
+  return ok and v == constexpr_containers::vector<int>{ 1, 2, 4 } and
+         v.capacity() == (spare ? 32 : 7);
+}
+
+static_assert(inplace(true));
+static_assert(inplace(false));
+
+constexpr bool append_uninitialized()
+{
+  constexpr_containers::vector<int> v{ 1, 2 };
+  const auto written = v.append_uninitialized(5, [](int* dst, std::size_t count) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      dst[i] = static_cast<int>(count + i);
+    }
+    return std::size_t{ 3 };
+  });
+  bool ok = written == 3 and v == constexpr_containers::vector<int>{ 1, 2, 5, 6, 7 } and
+            v.capacity() == 7;
+
+  // One element at a time, the capacity grows geometrically rather than by one
+  int reallocations = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const auto capacity = v.capacity();
+    v.append_uninitialized(1, [i](int* dst, std::size_t) {
+      *dst = i;
+      return std::size_t{ 1 };
+    });
+    reallocations += v.capacity() != capacity;
+  }
+  return ok and v.size() == 1005 and v[1004] == 999 and reallocations < 10;
+}
+
+static_assert(append_uninitialized());
+
+// Stability and scratch construction with a non-trivial element type
+bool inplace_strings(std::size_t spare)
+{
+  std::vector<std::string> ref;
+  for (int i = 0; i < 300; ++i) {
+    ref.push_back(std::to_string(i * 7919 % 101) + "/" + std::to_string(i));
+  }
+  const auto key = [](const std::string& s) { return std::stoi(s); };
+  const auto by_key = [&](const std::string& a, const std::string& b) { return key(a) < key(b); };
+  const auto odd = [&](const std::string& s) { return key(s) % 2 == 1; };
+
+  constexpr_containers::vector<std::string> v(ref.begin(), ref.end());
+  v.reserve(v.size() + spare);
+  std::stable_sort(v.begin(), v.begin() + 120, by_key);
+  std::stable_sort(v.begin() + 120, v.end(), by_key);
+  std::stable_sort(ref.begin(), ref.begin() + 120, by_key);
+  std::stable_sort(ref.begin() + 120, ref.end(), by_key);
+  v.merge_inplace(v.begin() + 120, by_key);
+  std::inplace_merge(ref.begin(), ref.begin() + 120, ref.end(), by_key);
+  bool ok = std::equal(v.begin(), v.end(), ref.begin(), ref.end());
+
+  v.stable_partition(odd);
+  std::stable_partition(ref.begin(), ref.end(), odd);
+  ok = ok and std::equal(v.begin(), v.end(), ref.begin(), ref.end());
+
+  v.sort_unique([&](const std::string& a, const std::string& b) { return key(a) < key(b); });
+  return ok and v.size() == 101;
+}
+
 int main()
 {
+  for (std::size_t spare : { 0, 10, 150, 300 }) {
+    if (not inplace_strings(spare)) {
+      return 1;
+    }
+  }
+
   [[maybe_unused]] std::array<int, f()> a;
+  static_assert(g() == 6);
   [[maybe_unused]] std::array<int, h()> c;
   std::cout << sizeof(constexpr_containers::vector<int>) << '\n';
   constexpr_containers::vector<int> v;
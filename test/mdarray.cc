@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/mdarray.h"
+
+namespace cec = constexpr_containers;
+
+using matrix_extents = cec::dextents<std::size_t, 2>;
+
+static_assert(matrix_extents::rank() == 2 and matrix_extents::rank_dynamic() == 2);
+static_assert(cec::extents<int, 3, cec::dynamic_extent>(5).extent(1) == 5);
+static_assert(cec::extents<int, 3, cec::dynamic_extent>(3, 5).extent(0) == 3);
+
+// Offsets of the three layouts on a 3 x 5 matrix
+static_assert(cec::layout_right::mapping<matrix_extents>(matrix_extents(3, 5))(1, 2) == 7);
+static_assert(cec::layout_left::mapping<matrix_extents>(matrix_extents(3, 5))(1, 2) == 7);
+static_assert(cec::layout_left::mapping<matrix_extents>(matrix_extents(3, 5)).stride(1) == 3);
+static_assert(cec::layout_tiled<2, 2>::mapping<matrix_extents>(matrix_extents(3, 5))(2, 3) ==
+              4 * 3 + 4 + 1);
+static_assert(
+  cec::layout_tiled<2, 2>::mapping<matrix_extents>(matrix_extents(3, 5)).required_span_size() ==
+  24);
+
+template<typename Layout>
+constexpr bool
+round_trip(std::size_t rows, std::size_t cols)
+{
+  cec::mdarray<int, matrix_extents, Layout> a(rows, cols);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      a(i, j) = int(i * 1000 + j);
+    }
+  }
+  cec::mdarray<int, matrix_extents, cec::layout_tiled<4, 8>> t(cols, rows);
+  cec::transpose(a.to_mdspan(), t.to_mdspan());
+  cec::mdarray<int, matrix_extents, cec::layout_left> back(rows, cols);
+  cec::transpose(std::as_const(t).to_mdspan(), back.to_mdspan());
+  cec::mdarray<int, matrix_extents, Layout> copied(rows, cols);
+  cec::copy(back.to_mdspan(), copied.to_mdspan());
+
+  bool ok = copied == a and t(cols - 1, rows - 1) == a(rows - 1, cols - 1);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      ok = ok and back(i, j) == int(i * 1000 + j);
+    }
+  }
+  return ok;
+}
+
+static_assert(round_trip<cec::layout_right>(5, 7));
+static_assert(round_trip<cec::layout_left>(7, 5));
+static_assert(round_trip<cec::layout_tiled<2, 4>>(3, 9));
+
+constexpr bool
+higher_rank()
+{
+  cec::mdarray<int, cec::extents<int, 2, 3, 4>> a;
+  a = cec::mdarray<int, cec::extents<int, 2, 3, 4>>(cec::extents<int, 2, 3, 4>());
+  int n = 0;
+  cec::for_each_index(a.extents(), [&](auto i, auto j, auto k) { a(i, j, k) = n++; });
+  cec::mdarray<int, cec::extents<int, 2, 3, 4>, cec::layout_left> b(
+    cec::extents<int, 2, 3, 4>{});
+  cec::copy(std::as_const(a).to_mdspan(), b.to_mdspan());
+  return n == 24 and a.container()[23] == 23 and b(1, 2, 3) == 23 and b.data()[1] == 12;
+}
+
+static_assert(higher_rank());
+
+// Views of different extents copy the elements at indices valid in both, and nothing past them
+template<typename SrcLayout, typename DstLayout>
+constexpr bool
+copies_overlap()
+{
+  cec::mdarray<int, matrix_extents, SrcLayout> a(3, 5);
+  cec::for_each_index(a.extents(), [&](auto i, auto j) { a(i, j) = int(i * 10 + j); });
+  cec::mdarray<int, matrix_extents, DstLayout> b(4, 2);
+  cec::copy(std::as_const(a).to_mdspan(), b.to_mdspan());
+  bool ok = true;
+  cec::for_each_index(b.extents(), [&](auto i, auto j) {
+    ok = ok and b(i, j) == (i < 3 ? int(i * 10 + j) : 0);
+  });
+
+  using cube = cec::dextents<int, 3>;
+  cec::mdarray<int, cube> c(cube(2, 2, 3));
+  cec::mdarray<int, cube> d(cube(3, 1, 2));
+  c(1, 0, 1) = 7;
+  cec::copy(std::as_const(c).to_mdspan(), d.to_mdspan());
+  return ok and d(1, 0, 1) == 7 and d(2, 0, 1) == 0;
+}
+
+static_assert(copies_overlap<cec::layout_right, cec::layout_right>());
+static_assert(copies_overlap<cec::layout_tiled<2, 2>, cec::layout_tiled<2, 2>>());
+static_assert(copies_overlap<cec::layout_left, cec::layout_right>());
+
+// Static extents transpose into their swap; a dynamic dst of the wrong shape gets the overlap only
+static_assert(cec::transposable_extents<cec::extents<int, 2, 3>, cec::extents<int, 3, 2>>());
+static_assert(not cec::transposable_extents<cec::extents<int, 2, 3>, cec::extents<int, 2, 3>>());
+static_assert(
+  cec::transposable_extents<cec::extents<int, 2, 3>, cec::extents<int, cec::dynamic_extent, 2>>());
+
+constexpr bool
+transposes_across_extents()
+{
+  cec::mdarray<int, cec::extents<int, 2, 3>> a(cec::extents<int, 2, 3>{});
+  cec::for_each_index(a.extents(), [&](auto i, auto j) { a(i, j) = int(i * 10 + j); });
+  cec::mdarray<int, cec::extents<int, 3, 2>, cec::layout_left> t(cec::extents<int, 3, 2>{});
+  cec::transpose(std::as_const(a).to_mdspan(), t.to_mdspan());
+  bool ok = t(2, 1) == 12 and t(0, 1) == 10;
+
+  cec::mdarray<int, matrix_extents> small(2, 1);
+  cec::transpose(std::as_const(a).to_mdspan(), small.to_mdspan());
+  return ok and small(0, 0) == 0 and small(1, 0) == 1 and small.container().size() == 2;
+}
+
+static_assert(transposes_across_extents());
+
+int
+main()
+{
+  // Sizes around the copy block, with partial tiles
+  for (std::size_t rows : { 1, 31, 32, 33, 100 }) {
+    for (std::size_t cols : { 1, 17, 64, 65 }) {
+      if (not round_trip<cec::layout_right>(rows, cols) or
+          not round_trip<cec::layout_tiled<8, 8>>(rows, cols)) {
+        return 1;
+      }
+    }
+  }
+
+  std::mt19937 rng(7);
+  cec::mdarray<double, matrix_extents, cec::layout_tiled<8, 8>> tiled(300, 200);
+  std::vector<double> column_sums(200);
+  std::vector<double> ref(200);
+  for (std::size_t i = 0; i < 300; ++i) {
+    for (std::size_t j = 0; j < 200; ++j) {
+      tiled(i, j) = double(rng() % 100);
+      ref[j] += tiled(i, j);
+    }
+  }
+  const auto view = std::as_const(tiled).to_mdspan();
+  for (std::size_t j = 0; j < 200; ++j) {
+    for (std::size_t i = 0; i < 300; ++i) {
+      column_sums[j] += view(i, j);
+    }
+  }
+  return column_sums == ref ? 0 : 1;
+}
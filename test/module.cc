@@ -0,0 +1,29 @@
+#include <new> // GCC 12 cannot see placement new through the import otherwise
+
+import constexpr_containers;
+
+namespace cec = constexpr_containers;
+
+constexpr int sum()
+{
+  cec::vector<int> v{ 1, 2 };
+  v.push_back(3);
+  return v[0] + v[1] + v[2];
+}
+
+static_assert(sum() == 6);
+
+int main()
+{
+  cec::vector<double> v(3, 1.5);
+  v.push_back(2.0);
+  cec::dary_heap<int, 4> heap;
+  heap.push(3);
+  heap.push(1);
+  cec::vector<int> small{ 5, 2, 9, 1 };
+  cec::small_sort(small);
+  if (v.size() != 4 or heap.top() != 3 or small != cec::vector<int>{ 1, 2, 5, 9 }) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <cstddef>
+#include <memory_resource>
+
+#include "constexpr_containers/pmr.h"
+
+namespace cec = constexpr_containers;
+
+int main()
+{
+  std::byte buffer[1024];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+  cec::pmr::vector<int> v(&resource);
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  if (v.size() != 10 or v[9] != 9 or v.get_allocator().resource() != &resource) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,205 @@
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/poly_vector.h"
+
+namespace cec = constexpr_containers;
+
+namespace {
+
+int live = 0;
+
+struct shape
+{
+  shape() { ++live; }
+  shape(const shape&) { ++live; }
+  virtual ~shape() { --live; }
+  virtual double area() const = 0;
+};
+
+struct square final : shape
+{
+  double side;
+  explicit square(double s)
+    : side(s)
+  {}
+  double area() const override { return side * side; }
+};
+
+// Non-trivial member, and a second base in front of shape so that the Base subobject is offset
+struct tagged
+{
+  std::uint64_t tag = 7;
+  virtual ~tagged() = default;
+};
+
+struct labelled final
+  : tagged
+  , shape
+{
+  std::string label;
+  alignas(16) double value;
+  labelled(std::string l, double v)
+    : label(std::move(l))
+    , value(v)
+  {}
+  double area() const override { return value + double(label.size()); }
+};
+
+// Copied on growth, as its move may throw; the copy throws once copies_left runs out
+struct fragile final : shape
+{
+  static inline int copies_left = 0;
+  double side = 3;
+  fragile() = default;
+  fragile(const fragile& other)
+    : shape(other)
+    , side(other.side)
+  {
+    if (--copies_left == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  double area() const override { return side; }
+};
+
+// Objects of 8, 32 and 24 bytes, aligned to 8, 16 and 8
+struct piece
+{
+  virtual ~piece() = default;
+};
+
+struct wide_piece final : piece
+{
+  alignas(16) char bytes[16] = {};
+};
+
+struct long_piece final : piece
+{
+  double x = 1;
+  double y = 2;
+};
+
+} // namespace
+
+static_assert(std::random_access_iterator<cec::poly_vector<shape>::iterator>);
+static_assert(std::random_access_iterator<cec::poly_vector<shape>::const_iterator>);
+
+bool
+growth_and_order()
+{
+  cec::poly_vector<shape> v;
+  std::vector<double> ref;
+  for (int i = 0; i < 500; ++i) {
+    if (i % 3 == 0) {
+      v.emplace_back<labelled>(std::string(i % 40, 'x'), i);
+      ref.push_back(i + i % 40);
+    } else {
+      v.emplace_back<square>(i);
+      ref.push_back(double(i) * i);
+    }
+  }
+  bool ok = v.size() == 500 and live == 500;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    ok = ok and v[i].area() == ref[i] and
+         reinterpret_cast<std::uintptr_t>(&v[i]) % alignof(shape) == 0;
+  }
+  ok = ok and v.type(0) == typeid(labelled) and v.type(1) == typeid(square);
+
+  v.group_by_type();
+  // labelled first, as it appears first, in their original relative order
+  std::vector<double> areas;
+  for (const auto& s : std::as_const(v)) {
+    areas.push_back(s.area());
+  }
+  std::vector<double> expected;
+  for (int i = 0; i < 500; i += 3) {
+    expected.push_back(ref[i]);
+  }
+  for (int i = 0; i < 500; ++i) {
+    if (i % 3 != 0) {
+      expected.push_back(ref[i]);
+    }
+  }
+  ok = ok and areas == expected and v.type(167) == typeid(square);
+
+  double squares = 0;
+  v.for_each_of<square>([&](square& s) { squares += s.side; });
+  ok = ok and squares == 500.0 * 499 / 2 - 3.0 * 166 * 167 / 2;
+
+  auto moved = std::move(v);
+  moved.pop_back();
+  ok = ok and moved.size() == 499 and v.empty() and live == 499 and
+       std::accumulate(moved.begin(), moved.end(), 0.0, [](double a, const shape& s) {
+         return a + s.area();
+       }) == std::accumulate(expected.begin(), expected.end() - 1, 0.0);
+  moved.clear();
+  return ok and live == 0 and moved.byte_capacity() >= moved.bytes_used();
+}
+
+// Grouping moves a 16-aligned object onto another boundary, which takes more padding than before
+bool
+grouping_grows()
+{
+  static_assert(sizeof(wide_piece) == 32 and alignof(wide_piece) == 16);
+  static_assert(sizeof(long_piece) == 24 and alignof(long_piece) == 8);
+  cec::poly_vector<piece> v;
+  v.reserve_bytes(80);
+  v.emplace_back<piece>();
+  v.emplace_back<piece>();
+  v.emplace_back<wide_piece>();
+  v.emplace_back<piece>();
+  v.emplace_back<long_piece>();
+  bool ok = v.bytes_used() == 80 and v.byte_capacity() == 80;
+  v.group_by_type();
+  ok = ok and v.bytes_used() == 88 and v.byte_capacity() >= v.bytes_used();
+  ok = ok and v.type(2) == typeid(piece) and v.type(3) == typeid(wide_piece);
+  return ok and dynamic_cast<long_piece&>(v[4]).y == 2;
+}
+
+// A copy that throws halfway through growth leaves the objects where they were
+bool
+growth_throws()
+{
+  cec::poly_vector<shape> v;
+  for (int i = 0; i < 10; ++i) {
+    v.emplace_back<fragile>();
+    v.emplace_back<square>(i);
+  }
+  const auto capacity = v.byte_capacity();
+  fragile::copies_left = 5;
+  try {
+    v.reserve_bytes(capacity + 1);
+    return false;
+  } catch (const std::runtime_error&) {
+  }
+  bool ok = v.size() == 20 and live == 20 and v.byte_capacity() == capacity;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    ok = ok and v[i].area() == (i % 2 == 0 ? 3.0 : double(i / 2) * double(i / 2));
+  }
+  fragile::copies_left = 100;
+  v.reserve_bytes(capacity + 1);
+  ok = ok and v.byte_capacity() > capacity and live == 20 and v[18].area() == 3.0;
+  v.clear();
+  return ok and live == 0;
+}
+
+int
+main()
+{
+  if (not growth_throws()) {
+    return 1;
+  }
+  if (not grouping_grows()) {
+    return 1;
+  }
+  if (not growth_and_order() or live != 0) {
+    return 1;
+  }
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "constexpr_containers/radix_heap.h"
+
+namespace cec = constexpr_containers;
+
+template<typename Queue>
+constexpr bool
+pops_in_order(Queue queue)
+{
+  const std::pair<unsigned, int> items[] = { { 7, 0 }, { 3, 1 }, { 12, 2 }, { 3, 3 }, { 9, 4 } };
+  queue.append(std::begin(items), std::end(items));
+  unsigned keys[8] = {};
+  int n = 0;
+  while (not queue.empty()) {
+    keys[n++] = unsigned(queue.top_key());
+    const auto value = queue.top();
+    queue.pop();
+    // Monotone pushes in between pops
+    if (value == 1) {
+      queue.push(5, 5);
+    }
+  }
+  const unsigned expected[] = { 3, 3, 5, 7, 9, 12 };
+  // Once empty, the last key popped
+  return n == 6 and std::equal(expected, expected + 6, keys) and queue.top_key() == 12;
+}
+
+static_assert(pops_in_order(cec::radix_heap<unsigned, int>()));
+static_assert(pops_in_order(cec::bucket_queue<int>(15)));
+
+// Interleaved pushes and pops with keys at most spread above the last one popped
+template<typename Queue>
+bool
+matches_sorted(Queue queue, std::uint32_t spread)
+{
+  std::mt19937 rng(3);
+  std::vector<std::uint64_t> ref;
+  std::uint64_t last = 0;
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < 500; ++i) {
+      const auto key = last + rng() % (spread + 1);
+      queue.push(key, std::uint32_t(key * 3));
+      ref.push_back(key);
+    }
+    std::sort(ref.begin(), ref.end(), std::greater<>());
+    for (int i = 0; i < 400; ++i) {
+      if (queue.top_key() != ref.back() or queue.top() != std::uint32_t(ref.back() * 3)) {
+        return false;
+      }
+      last = ref.back();
+      ref.pop_back();
+      queue.pop();
+    }
+  }
+  return queue.size() == ref.size();
+}
+
+int
+main()
+{
+  if (not matches_sorted(cec::radix_heap<std::uint64_t, std::uint32_t>(), 1u << 30) or
+      not matches_sorted(cec::radix_heap<std::uint32_t, std::uint32_t>(), 1000) or
+      not matches_sorted(cec::bucket_queue<std::uint32_t>(1000), 1000)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "constexpr_containers/set_algorithm.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+constexpr bool small_sets()
+{
+  cec::vector<int> a{ 1, 3, 5, 7, 9 };
+  cec::vector<int> b{ 2, 3, 4, 9, 10 };
+  cec::vector<int> both, either, only_a;
+  cec::set_intersection(a, b, both);
+  cec::set_union(a, b, either);
+  cec::set_difference(a, b, only_a);
+
+  const cec::vector<int> c{ 0, 11 };
+  const std::span<const int> lists[] = { as_span(a), as_span(b), as_span(c) };
+  cec::vector<int> merged, united;
+  cec::kway_merge(std::span(lists), merged);
+  cec::kway_union(std::span(lists), united);
+
+  return both == cec::vector<int>{ 3, 9 } and
+         either == cec::vector<int>{ 1, 2, 3, 4, 5, 7, 9, 10 } and
+         only_a == cec::vector<int>{ 1, 5, 7 } and
+         merged == cec::vector<int>{ 0, 1, 2, 3, 3, 4, 5, 7, 9, 9, 10, 11 } and
+         united == cec::vector<int>{ 0, 1, 2, 3, 4, 5, 7, 9, 10, 11 };
+}
+
+constexpr bool skewed_sets()
+{
+  cec::vector<unsigned> large;
+  for (unsigned i = 0; i < 1000; ++i) {
+    large.push_back(2 * i);
+  }
+  cec::vector<unsigned> small{ 1, 4, 1998, 5000 };
+  cec::vector<unsigned> both, either, only_large, only_small;
+  cec::set_intersection(small, large, both);
+  cec::set_union(small, large, either);
+  cec::set_difference(large, small, only_large);
+  cec::set_difference(small, large, only_small);
+  return both == cec::vector<unsigned>{ 4, 1998 } and either.size() == 1002 and
+         std::is_sorted(either.begin(), either.end()) and only_large.size() == 998 and
+         only_small == cec::vector<unsigned>{ 1, 5000 };
+}
+
+static_assert(small_sets());
+static_assert(skewed_sets());
+
+// Sorted, duplicate-free sample of n values below limit
+std::vector<std::uint32_t> sample(std::mt19937& rng, std::size_t n, std::uint32_t limit)
+{
+  std::uniform_int_distribution<std::uint32_t> dist(0, limit - 1);
+  std::vector<std::uint32_t> out(n);
+  for (auto& v : out) {
+    v = dist(rng);
+  }
+  std::sort(out.begin(), out.end());
+  out.erase(std::unique(out.begin(), out.end()), out.end());
+  return out;
+}
+
+template<typename Op, typename Ref>
+bool matches(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, Op op, Ref ref)
+{
+  cec::vector<std::uint32_t> out;
+  op(a, b, out);
+  std::vector<std::uint32_t> expected;
+  ref(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  return std::equal(out.begin(), out.end(), expected.begin(), expected.end());
+}
+
+int main()
+{
+  std::mt19937 rng(42);
+  const std::size_t sizes[] = { 0, 1, 7, 8, 100, 1000, 100000 };
+  for (auto n : sizes) {
+    for (auto m : sizes) {
+      for (std::uint32_t limit : { 64u, 4096u, 1u << 20 }) {
+        const auto a = sample(rng, n, limit);
+        const auto b = sample(rng, m, limit);
+        const auto intersect = [](auto a, auto b, auto& out) { cec::set_intersection(a, b, out); };
+        const auto unite = [](auto a, auto b, auto& out) { cec::set_union(a, b, out); };
+        const auto subtract = [](auto a, auto b, auto& out) { cec::set_difference(a, b, out); };
+        const auto ref_intersect = [](auto... args) { return std::set_intersection(args...); };
+        const auto ref_unite = [](auto... args) { return std::set_union(args...); };
+        const auto ref_subtract = [](auto... args) { return std::set_difference(args...); };
+        if (not matches(a, b, intersect, ref_intersect) or not matches(a, b, unite, ref_unite) or
+            not matches(a, b, subtract, ref_subtract)) {
+          return 1;
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<std::uint32_t>> lists;
+  std::vector<std::span<const std::uint32_t>> spans;
+  std::vector<std::uint32_t> all;
+  for (auto n : sizes) {
+    lists.push_back(sample(rng, n, 1u << 16));
+  }
+  for (const auto& list : lists) {
+    spans.emplace_back(list);
+    all.insert(all.end(), list.begin(), list.end());
+  }
+  std::sort(all.begin(), all.end());
+  cec::vector<std::uint32_t> merged, united;
+  cec::kway_merge(std::span<const std::span<const std::uint32_t>>(spans), merged);
+  cec::kway_union(std::span<const std::span<const std::uint32_t>>(spans), united);
+  if (not std::equal(merged.begin(), merged.end(), all.begin(), all.end())) {
+    return 1;
+  }
+  all.erase(std::unique(all.begin(), all.end()), all.end());
+  if (not std::equal(united.begin(), united.end(), all.begin(), all.end())) {
+    return 1;
+  }
+  return 0;
+}
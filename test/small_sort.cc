@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "constexpr_containers/small_sort.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+static_assert(cec::sorting_network<0>::size == 0);
+static_assert(cec::sorting_network<2>::size == 1);
+static_assert(cec::sorting_network<4>::size == 5 and cec::sorting_network<4>::depth == 3);
+static_assert(cec::sorting_network<8>::size == 19 and cec::sorting_network<8>::depth == 6);
+static_assert(cec::sorting_network<16>::size == 63 and cec::sorting_network<16>::depth == 10);
+static_assert(cec::sorting_network<32>::size == 191 and cec::sorting_network<32>::depth == 15);
+
+// By the 0-1 principle, a network sorts everything if it sorts every sequence of 0s and 1s
+template<std::size_t N>
+constexpr bool sorts_all_bit_patterns()
+{
+  for (std::uint32_t bits = 0; bits < (std::uint32_t{ 1 } << N); ++bits) {
+    std::array<int, N> a{};
+    for (std::size_t i = 0; i < N; ++i) {
+      a[i] = (bits >> i) & 1;
+    }
+    cec::network_sort<N>(a.begin());
+    if (not std::is_sorted(a.begin(), a.end())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(sorts_all_bit_patterns<3>());
+static_assert(sorts_all_bit_patterns<6>());
+static_assert(sorts_all_bit_patterns<7>());
+
+constexpr bool sorts_vectors()
+{
+  cec::vector<int> v{ 5, -1, 9, 3, 3, 0, 12 };
+  cec::small_sort(v);
+  cec::vector<int> w{ 4, 1, 3 };
+  cec::small_sort(w, std::greater<>());
+  return v == cec::vector<int>{ -1, 0, 3, 3, 5, 9, 12 } and w == cec::vector<int>{ 4, 3, 1 };
+}
+
+static_assert(sorts_vectors());
+
+// Not constexpr, so that the compiler does not try to fold it
+template<std::size_t N>
+bool sorts_all_bit_patterns_at_runtime()
+{
+  std::array<int, N> a{};
+  for (std::uint32_t bits = 0; bits < (std::uint32_t{ 1 } << N); ++bits) {
+    for (std::size_t i = 0; i < N; ++i) {
+      a[i] = (bits >> i) & 1;
+    }
+    cec::network_sort<N>(a.begin());
+    if (not std::is_sorted(a.begin(), a.end())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<std::size_t... N>
+bool all_bit_patterns(std::index_sequence<N...>)
+{
+  return (sorts_all_bit_patterns_at_runtime<N>() and ...);
+}
+
+template<typename T, typename Compare = std::less<>>
+bool matches_std_sort(std::mt19937& rng, Compare comp = Compare())
+{
+  std::uniform_int_distribution<int> value(-50, 50);
+  for (std::size_t n = 0; n <= 40; ++n) {
+    for (int rep = 0; rep < 200; ++rep) {
+      cec::vector<T> v(n);
+      for (auto& x : v) {
+        x = static_cast<T>(value(rng));
+      }
+      auto expected = v;
+      std::sort(expected.begin(), expected.end(), comp);
+      cec::small_sort(v, comp);
+      if (v != expected) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main()
+{
+  // Up to 16 at runtime, larger ones are covered by random inputs
+  if (not all_bit_patterns(std::make_index_sequence<17>())) {
+    return 1;
+  }
+  std::mt19937 rng(7);
+  if (not matches_std_sort<std::int32_t>(rng) or not matches_std_sort<std::uint32_t>(rng) or
+      not matches_std_sort<float>(rng) or not matches_std_sort<double>(rng) or
+      not matches_std_sort<std::int32_t>(rng, std::greater<>()) or
+      not matches_std_sort<std::int64_t>(rng)) {
+    return 1;
+  }
+
+  // Extreme values, which must not be confused with the SIMD padding
+  cec::vector<std::int32_t> ints{ std::numeric_limits<std::int32_t>::max(), 0,
+                                  std::numeric_limits<std::int32_t>::min() };
+  cec::small_sort(ints);
+  cec::vector<float> floats{ std::numeric_limits<float>::infinity(), 1.0F,
+                             -std::numeric_limits<float>::infinity() };
+  cec::small_sort(floats);
+  if (ints[0] != std::numeric_limits<std::int32_t>::min() or
+      ints[2] != std::numeric_limits<std::int32_t>::max() or
+      floats[0] != -std::numeric_limits<float>::infinity() or floats[1] != 1.0F) {
+    return 1;
+  }
+
+  cec::vector<std::string> strings{ "pear", "apple", "fig", "banana" };
+  cec::small_sort(strings);
+  if (strings != cec::vector<std::string>{ "apple", "banana", "fig", "pear" }) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+#include "constexpr_containers/soa.h"
+#include "constexpr_containers/vector.h"
+
+namespace cec = constexpr_containers;
+
+struct point
+{
+  float x;
+  float y;
+};
+
+struct record
+{
+  std::int32_t id;
+  float price;
+  std::int32_t quantity;
+  float weight;
+};
+
+constexpr bool round_trips()
+{
+  cec::vector<std::tuple<int, char>> rows{ { 1, 'a' }, { 2, 'b' }, { 3, 'c' } };
+  cec::vector<int> ints;
+  cec::vector<char> chars;
+  cec::to_columns(rows, ints, chars);
+  cec::vector<std::tuple<int, char>> back;
+  cec::from_columns(back, ints, chars);
+  return ints == cec::vector<int>{ 1, 2, 3 } and chars == cec::vector<char>{ 'a', 'b', 'c' } and
+         back == rows;
+}
+
+static_assert(round_trips());
+
+int main()
+{
+  const std::size_t n = 1000003;
+  cec::vector<record> records(n);
+  cec::vector<point> points(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    records[i] = { std::int32_t(i), i * 0.5f, std::int32_t(i % 7), i * 0.25f };
+    points[i] = { i * 1.0f, i * 2.0f };
+  }
+
+  cec::vector<std::int32_t> id, quantity;
+  cec::vector<float> price, weight, x, y;
+  cec::to_columns<&record::id, &record::price, &record::quantity, &record::weight>(
+    records, id, price, quantity, weight);
+  cec::to_columns<&point::x, &point::y>(points, x, y);
+  // Out of declaration order, so this one takes the generic path
+  cec::vector<float> y2, x2;
+  cec::to_columns<&point::y, &point::x>(points, y2, x2);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (id[i] != records[i].id or price[i] != records[i].price or
+        weight[i] != records[i].weight or quantity[i] != records[i].quantity or
+        x[i] != points[i].x or y[i] != points[i].y or x2[i] != x[i] or y2[i] != y[i]) {
+      return 1;
+    }
+  }
+
+  // Columns of other types than their fields convert element by element, whatever the SIMD path
+  cec::vector<double> xd, yd;
+  cec::vector<int> xi;
+  cec::vector<std::int32_t> yi;
+  cec::vector<std::int64_t> id64, quantity64;
+  cec::vector<double> price_d, weight_d;
+  cec::to_columns<&point::x, &point::y>(points, xd, yd);
+  cec::to_columns<&point::x, &point::y>(points, xi, yi);
+  cec::to_columns<&record::id, &record::price, &record::quantity, &record::weight>(
+    records, id64, price_d, quantity64, weight_d);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (xd[i] != points[i].x or yd[i] != points[i].y or xi[i] != static_cast<int>(points[i].x) or
+        yi[i] != static_cast<std::int32_t>(points[i].y) or id64[i] != records[i].id or
+        price_d[i] != records[i].price or quantity64[i] != records[i].quantity or
+        weight_d[i] != records[i].weight) {
+      return 3;
+    }
+  }
+  cec::vector<point> points3;
+  cec::from_columns<&point::x, &point::y>(points3, xi, yi);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (points3[i].x != static_cast<float>(xi[i]) or points3[i].y != static_cast<float>(yi[i])) {
+      return 4;
+    }
+  }
+
+  // Narrower columns, on values they can hold
+  const std::size_t small = 10007;
+  cec::vector<point> small_points(points.begin(), points.begin() + small);
+  cec::vector<std::int16_t> xs, ys;
+  cec::to_columns<&point::x, &point::y>(small_points, xs, ys);
+  for (std::size_t i = 0; i < small; ++i) {
+    if (xs.size() != small or xs[i] != static_cast<std::int16_t>(i) or
+        ys[i] != static_cast<std::int16_t>(2 * i)) {
+      return 5;
+    }
+  }
+
+  cec::vector<record> records2;
+  cec::vector<point> points2;
+  cec::from_columns<&record::id, &record::price, &record::quantity, &record::weight>(
+    records2, id, price, quantity, weight);
+  cec::from_columns<&point::x, &point::y>(points2, x, y);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (records2[i].id != records[i].id or records2[i].price != records[i].price or
+        records2[i].quantity != records[i].quantity or records2[i].weight != records[i].weight or
+        points2[i].x != points[i].x or points2[i].y != points[i].y) {
+      return 2;
+    }
+  }
+}
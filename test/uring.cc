@@ -0,0 +1,78 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "constexpr_containers/uring.h"
+
+namespace cec = constexpr_containers;
+
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+// Writes then reads back a file through the ring, with more operations than it holds
+bool
+round_trips()
+{
+  char path[] = "/tmp/constexpr_containers_uring_XXXXXX";
+  const int fd = ::mkstemp(path);
+  if (fd < 0) {
+    return false;
+  }
+  cec::uring ring(4);
+  bool ok = ring.entries() == 4;
+
+  char out[10][8];
+  iovec out_iov[10];
+  for (int i = 0; i < 10; ++i) {
+    std::snprintf(out[i], sizeof(out[i]), "block%02d", i);
+    out_iov[i] = { out[i], 8 };
+  }
+  int next = 0;
+  int done = 0;
+  while (done < 10) {
+    while (next < 10 and ring.prepare(IORING_OP_WRITEV, fd, &out_iov[next], 1, 8 * next, next)) {
+      ++next;
+    }
+    ok = ok and ring.in_flight() <= 4;
+    ring.submit(1);
+    done += static_cast<int>(ring.reap([&](std::uint64_t i, std::int32_t result) {
+      ok = ok and i < 10 and result == 8;
+    }));
+  }
+
+  char in[80];
+  iovec in_iov{ in, sizeof(in) };
+  ok = ok and ring.prepare(IORING_OP_READV, fd, &in_iov, 1, 0, 42);
+  ring.submit(1);
+  ok = ok and ring.reap([&](std::uint64_t i, std::int32_t result) {
+    ok = ok and i == 42 and result == 80;
+  }) == 1;
+  ok = ok and std::strcmp(in, "block00") == 0 and std::strcmp(in + 72, "block09") == 0;
+
+  // Errors come back as -errno
+  ok = ok and ring.prepare(IORING_OP_READV, -1, &in_iov, 1, 0, 0);
+  ring.submit(1);
+  ring.reap([&](std::uint64_t, std::int32_t result) { ok = ok and result == -EBADF; });
+
+  ::close(fd);
+  std::remove(path);
+  return ok and ring.in_flight() == 0;
+}
+#endif
+
+int
+main()
+{
+#if CONSTEXPR_CONTAINERS_HAS_IO_URING
+  // Sandboxes may forbid io_uring, which is what available() is for
+  if (cec::uring::available() and not round_trips()) {
+    return 1;
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "constexpr_containers/variant_vector.h"
+
+namespace cec = constexpr_containers;
+
+struct point
+{
+  int x, y;
+};
+
+using shapes = cec::variant_vector<int, double, point>;
+
+static_assert(shapes::alternative_bits == 2 and shapes::position_bits == 30);
+static_assert(shapes::alternative_of<point> == 2);
+static_assert(cec::variant_vector<int>::alternative_bits == 0);
+
+constexpr bool
+ordered_and_batched()
+{
+  shapes v;
+  v.push_back(1);
+  v.push_back(2.5);
+  v.emplace_back<point>(3, 4);
+  v.push_back(5);
+  const int x = 6;
+  v.push_back(x);
+
+  // Ordered visits see the insertion order
+  double ordered = 0;
+  v.for_each([&](const auto& e) {
+    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(e)>, point>) {
+      ordered = ordered * 10 + e.x + e.y;
+    } else {
+      ordered = ordered * 10 + e;
+    }
+  });
+
+  // Batches go column by column
+  int kinds = 0;
+  v.visit_all([&]<typename T>(T&) { kinds = kinds * 10 + int(shapes::alternative_of<T>) + 1; });
+
+  const auto kind = v.visit(2, [](const auto& e) { return sizeof(e); });
+  bool ok = ordered == 12.5 * 1000 + 700 + 50 + 6 and kinds == 11123 and kind == sizeof(point) and
+            v.holds<point>(2) and v.get<int>(3) == 5 and v.column<int>().size() == 3;
+
+  v.pop_back();
+  v.pop_back();
+  ok = ok and v.size() == 3 and v.column<int>().size() == 1 and v.index(2) == 2;
+  v.clear();
+  return ok and v.empty() and v.column<double>().empty();
+}
+
+static_assert(ordered_and_batched());
+
+// Matches a vector of std::variant under random pushes and pops
+bool
+matches_variants()
+{
+  using element = std::variant<std::string, std::uint64_t, point>;
+  std::vector<element> ref;
+  cec::variant_vector<std::string, std::uint64_t, point> v;
+  std::mt19937 rng(11);
+  for (int i = 0; i < 20000; ++i) {
+    const auto r = rng();
+    if (r % 7 == 0 and not ref.empty()) {
+      ref.pop_back();
+      v.pop_back();
+    } else if (r % 3 == 0) {
+      ref.emplace_back(std::string(r % 50, 'q'));
+      v.emplace_back<std::string>(r % 50, 'q');
+    } else if (r % 3 == 1) {
+      ref.emplace_back(std::uint64_t{ r });
+      v.push_back(std::uint64_t{ r });
+    } else {
+      ref.emplace_back(point{ int(r % 100), i });
+      v.push_back(point{ int(r % 100), i });
+    }
+  }
+  if (v.size() != ref.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < ref.size(); ++i) {
+    const bool same = v.visit(i, [&]<typename T>(const T& e) {
+      const auto* expected = std::get_if<T>(&ref[i]);
+      if constexpr (std::is_same_v<T, point>) {
+        return expected and expected->x == e.x and expected->y == e.y;
+      } else {
+        return expected and *expected == e;
+      }
+    });
+    if (not same) {
+      return false;
+    }
+  }
+  std::size_t strings = 0;
+  v.visit_all([&]<typename T>(const T&) { strings += std::is_same_v<T, std::string>; });
+  return strings == v.column<std::string>().size();
+}
+
+int
+main()
+{
+  return matches_variants() ? 0 : 1;
+}
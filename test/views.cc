@@ -0,0 +1,51 @@
+#include <atomic>
+#include <numeric>
+#include <ranges>
+
+#include "constexpr_containers/vector.h"
+#include "constexpr_containers/views.h"
+
+namespace cec = constexpr_containers;
+
+static_assert(std::ranges::random_access_range<cec::chunk_view<int>>);
+static_assert(std::ranges::sized_range<cec::chunk_view<int>>);
+static_assert(std::ranges::contiguous_range<std::ranges::range_value_t<cec::chunk_view<int>>>);
+static_assert(std::ranges::random_access_range<cec::strided_view<const int>>);
+static_assert(std::ranges::view<cec::strided_view<int>>);
+
+constexpr bool chunks_and_strides()
+{
+  cec::vector<int> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  auto c = v | cec::chunks(4);
+  auto s = cec::strided(v, 3);
+  int strided_sum = 0;
+  for (int x : s) {
+    strided_sum += x;
+  }
+  int chunked_sum = 0;
+  cec::for_each_chunk(v, 3, [&](auto chunk) {
+    for (int x : chunk) {
+      chunked_sum += x;
+    }
+  });
+  return c.size() == 3 and c[2].size() == 2 and c[1][0] == 4 and s.size() == 4 and
+         strided_sum == 18 and chunked_sum == 45 and (v | cec::chunks_by_bytes(8)).size() == 5;
+}
+
+static_assert(chunks_and_strides());
+
+int main()
+{
+  cec::vector<int> v(100000);
+  std::iota(v.begin(), v.end(), 0);
+  std::atomic<long> sum = 0;
+  cec::for_each_chunk(
+    v,
+    1000,
+    [&](auto chunk) { sum += std::accumulate(chunk.begin(), chunk.end(), 0l); },
+    4);
+  return sum == 4999950000l ? 0 : 1;
+}